@@ -1,6 +1,29 @@
 #include "stm32l476xx.h"
 #include "led_setup.h"
 #include "buttons.h"
+#include "debounce_bench.h"
+#include "wcet.h"
+#include "memmap.h"
+#include "irq.h"
+#include "capture.h"
+#include "analog.h"
+#include "matrix.h"
+#include "brightness.h"
+#include "keypad.h"
+#include "store.h"
+#include "boottime.h"
+#include "multiball.h"
+#include "link.h"
+#include "netplay.h"
+#include "sched.h"
+#include "coro.h"
+#include "swtimer.h"
+#include "sampler.h"
+#include "tickless.h"
+#include "load.h"
+#include "stack.h"
+#include "standby.h"
+#include "sound.h"
 
 /**
  ===================================================================
@@ -13,11 +36,34 @@
  *  In this lab, pins are enabled to light LEDs in two modes:
  *  PLAY_MODE and FLASH_LED_MODE.
  *  Two buttons are used to interact with the game and SysTick is
- *  used for regular timing.
+ *  used for regular timing. Each tick pends PendSV, which runs the
+ *  game step at the lowest interrupt priority (see irq.h).
  *  In PLAY_MODE, a pong game is emulated using a led array.
+ *  MULTIBALL_MODE plays on all 8 rows of the LED matrix at once,
+ *  and every return launches another ball (multiball.c).
+ *  NET_MODE plays one game across two boards linked on USART1:
+ *  each board has one paddle and shows its half of a 16-LED court
+ *  (link.c, netplay.c). Build the second board with
+ *  -DNET_LOCAL_PLAYER=2 and switch both boards to the mode.
+ *  DIAG_MODE shows the CPU load as a bar on the playfield LEDs
+ *  (load.c).
+ *  Left waiting for a serve, the board goes to Standby; the user
+ *  button wakes it with the same frame on the LEDs (standby.c).
+ *  Hits, misses and wins play a sound on the DAC (PA4); the
+ *  waveform is fed by DMA, so it costs the game nothing (sound.c).
  *  The farthest left and right leds(blue and red) are the "paddles".
- *  The user button toggles between modes. 
- *   Debouncing is handled by Timer2 interupt.
+ *  Everything outside the interrupts runs as tasks of an EDF
+ *  scheduler (sched.c) that sleeps the core when none is ready.
+ *  The user button steps through the modes in gameModes[]. Each
+ *  mode is a descriptor (hooks + SysTick period), so switching is a
+ *  pointer swap and the handlers never branch on the mode.
+ *  PLAY_MODE is tickless: instead of a SysTick period it arms the
+ *  time of its next ball step on TIM5 (tickless.c), and button
+ *  edges wake it directly.
+ *   Buttons are sampled by TIM16 + DMA and debounced in batches
+ *  (sampler.c), or by the Timer2 interupt in INPUT_TIM2 builds.
+ *  Scores, server, speed and mode are kept in flash (store.c) and
+ *  restored after a reset.
  ===========================================================================
  */
 
@@ -27,9 +73,31 @@
 #define SPEED_STEP         100000 // speed increment
 #define INITIAL_SPEED      600000
 #define FLASH_MODE_SPEED   20000  // ~5ms tick = 200Hz (4MHz / 20000)
+#define SPIN_MAX           50000  // extra speed from a paddle at full scale
+#define MULTIBALL_SPEED    300000 // 75 ms per step
+#define MULTIBALL_SWING    2      // ticks a press keeps the paddle swinging
+#define MULTIBALL_MAX      12     // no new balls beyond this
+#define NET_SPEED          200000 // 50 ms per tick, the same on both boards
+#define DIAG_SPEED         400000 // 100 ms per load bar refresh
+#define WIN_POLL           (FLASH_STEP_MS * 4000)  // STATE_WIN wake-ups, TIM5 counts
 
-// === Game States for PLAY_MODE ===
-typedef enum {
+// Signed distance a - b for the wrapping 32-bit TIM5 count
+#define TIME_DIFF(a, b) ((int32_t)((a) - (b)))
+
+// Main loop tasks: period and deadline in ms
+#define INPUT_PERIOD_MS    5      // user button and mode input
+#define STORE_PERIOD_MS    10     // flash store steps (erase ~22 ms)
+#define STATS_PERIOD_MS    1000
+#define TIMER_DEADLINE_MS  5      // software timer callbacks, once due
+#define LOAD_WINDOW_MS     250    // CPU load meter window
+#define STANDBY_CHECK_MS   1000   // idle check for Standby
+
+#ifndef NET_LOCAL_PLAYER
+#define NET_LOCAL_PLAYER   1      // paddle on this board (1 = left half)
+#endif
+
+// === Game States for PLAY_MODE (one byte in SRAM2) ===
+typedef enum __attribute__((packed)) {
     STATE_SERVE,
     STATE_SHIFT_LEFT,
     STATE_SHIFT_RIGHT,
@@ -40,20 +108,161 @@ typedef enum {
     STATE_WIN
 } PongState;
 
+// === Mode descriptors ===
+// tick runs in PendSV on every SysTick, input runs in the main loop.
+// Hooks are never NULL (noModeHook), so calls need no checks.
+// A tickless mode has no tickPeriod: SysTick is stopped, and tick
+// runs when the event it armed with ticklessArm() is due or a
+// button edge comes in.
+typedef struct {
+    void (*enter)(void);
+    void (*exit)(void);
+    void (*tick)(void);
+    void (*input)(void);
+    const uint32_t *tickPeriod;   // SysTick reload, read on entry; NULL = tickless
+} GameMode;
+
+// === Main loop tasks (index = sched.c task id) ===
+typedef enum {
+    TASK_INPUT,
+    TASK_STORE,
+    TASK_STATS,
+    TASK_TIMERS,
+    TASK_LOAD,
+    TASK_STANDBY,
+    NUM_TASKS
+} TaskId;
+
 // === Global Variables ===
-static PongState gameState = STATE_SERVE;
+SRAM2_DATA static PongState gameState = STATE_SERVE;
+static Coro winCo;                   // STATE_WIN flow
 static uint8_t player1Score = 0;
 static uint8_t player2Score = 0;
 uint32_t currentSpeed = INITIAL_SPEED;
-uint32_t msTimer = 0;
+
+// Reaction times in TIM5 counts (ball reaches paddle -> first press edge)
+static uint32_t paddleArrival = 0;
+static uint32_t stepAt;             // PLAY_MODE: TIM5 time of the next ball step
+int32_t reactionTime[2] = {0, 0};   // [0] = player 1 (left), [1] = player 2 (right)
+
+static const uint32_t flashModeSpeed = FLASH_MODE_SPEED;
+static const uint32_t multiballSpeed = MULTIBALL_SPEED;
+
+// MULTIBALL_MODE state ([0] = player 1 / left button, [1] = player 2)
+static Multiball court;
+static uint8_t swingTicks[2];
+static uint8_t paddleHeld[2];
+static uint8_t multiScore[2];
+static uint8_t nextLane;
+static uint8_t multiWinner;          // round over, flash running
+
+// NET_MODE state
+static NetSession netSession;
+static const uint32_t netSpeed = NET_SPEED;
+static uint8_t netShown[2];          // scores on the LEDs
+
+// DIAG_MODE state
+static const uint32_t diagSpeed = DIAG_SPEED;
+static uint8_t diagSavedPattern;     // playfield to put back on exit
+
+// TIM5 time of the latest button edge, for the Standby idle check
+static volatile uint32_t lastInput;
+static uint8_t wakePress;            // user button press that ended Standby
+
+// Handlers over their WCET budget, refreshed by the stats task
+volatile uint32_t wcetAlarms = 0;
 
 // Function prototypes
+static void playTick(void);
+static void playEnter(void);
+static void playExit(void);
+static uint8_t playStep(uint32_t now);
+static void nextStep(uint32_t now);
+static void startModeClock(void);
+static void flashEnter(void);
+static void noModeHook(void);
+static void multiballTick(void);
+static void multiballEnter(void);
+static void multiballExit(void);
+static void netTick(void);
+static void netEnter(void);
+static void netExit(void);
+static void diagTick(void);
+static void diagEnter(void);
+static void diagExit(void);
+static void switchMode(uint8_t mode);
+static void applySpin(uint8_t paddle);
+static void saveGame(void);
+static void restoreGame(void);
+static void redrawLeds(void);
+static void inputTask(void);
+static void storeTask(void);
+static void statsTask(void);
+static void timersTask(void);
+static void loadTask(void);
+static void standbyTask(void);
+static uint8_t resumeGame(void);
+static uint8_t winFlow(Coro *co);
 void configureSysTick(uint32_t reloadValue);
+#ifdef INPUT_TIM2
 void configureTimer(void);
 void TIM2_IRQHandler(void);
+#endif
 void SysTick_Handler(void);
+void PendSV_Handler(void);
 void handleFlashLedMode(void);
 
+// Indexed by led_mode. Add a mode: one entry here plus its hooks.
+static const GameMode gameModes[] = {
+    [PLAY_MODE] = {
+        .enter = playEnter,  .exit = playExit,
+        .tick  = playTick,   .input = noModeHook,
+        .tickPeriod = 0                    // tickless, paced by currentSpeed
+    },
+    [FLASH_LED_MODE] = {
+        .enter = flashEnter, .exit = noModeHook,
+        .tick  = noModeHook, .input = handleFlashLedMode,
+        .tickPeriod = &flashModeSpeed
+    },
+    [MULTIBALL_MODE] = {
+        .enter = multiballEnter, .exit = multiballExit,
+        .tick  = multiballTick,  .input = noModeHook,
+        .tickPeriod = &multiballSpeed
+    },
+    [NET_MODE] = {
+        .enter = netEnter, .exit = netExit,
+        .tick  = netTick,  .input = noModeHook,
+        .tickPeriod = &netSpeed
+    },
+    [DIAG_MODE] = {
+        .enter = diagEnter, .exit = diagExit,
+        .tick  = diagTick,  .input = noModeHook,
+        .tickPeriod = &diagSpeed
+    }
+};
+#define NUM_MODES (sizeof(gameModes) / sizeof(gameModes[0]))
+
+static const GameMode *volatile activeMode = &gameModes[PLAY_MODE];
+
+static const SchedTask tasks[NUM_TASKS] = {
+    [TASK_INPUT] = { inputTask, INPUT_PERIOD_MS * SCHED_COUNTS_PER_MS,
+                     INPUT_PERIOD_MS * SCHED_COUNTS_PER_MS },
+    [TASK_STORE] = { storeTask, STORE_PERIOD_MS * SCHED_COUNTS_PER_MS,
+                     STORE_PERIOD_MS * SCHED_COUNTS_PER_MS },
+    [TASK_STATS] = { statsTask, STATS_PERIOD_MS * SCHED_COUNTS_PER_MS,
+                     STATS_PERIOD_MS * SCHED_COUNTS_PER_MS },
+    [TASK_TIMERS] = { timersTask, 0,       // released by timerWake()
+                      TIMER_DEADLINE_MS * SCHED_COUNTS_PER_MS },
+    [TASK_LOAD]  = { loadTask, LOAD_WINDOW_MS * SCHED_COUNTS_PER_MS,
+                     LOAD_WINDOW_MS * SCHED_COUNTS_PER_MS },
+    [TASK_STANDBY] = { standbyTask, STANDBY_CHECK_MS * SCHED_COUNTS_PER_MS,
+                       STANDBY_CHECK_MS * SCHED_COUNTS_PER_MS }
+};
+
+#ifdef WCET_BENCH
+static void runWcetBench(void);
+#endif
+
 /******************************************
 //main function
 // Handles Initialization of pins and state machine.
@@ -61,86 +270,253 @@ void handleFlashLedMode(void);
 *******************************************/
 int main(void)
 {
-    // Initialize buttons and LEDs
+    uint8_t resumed;
+
+#ifdef DEBOUNCE_BENCH
+    // Compare debounce strategies on the synthetic waveforms; results
+    // land in debounceBenchResults[]. The recorded profile runs from
+    // statsTask() once the left button has been captured.
+    runDebounceBench();
+#endif
+
+    // --- Fast path: only what the first frame needs ---
     init_Buttons();
+    bootMark(BOOT_BUTTONS);
     init_LEDs_PC5to12();
+    bootMark(BOOT_LEDS);
+
+    // Woken from Standby: the retained frame goes straight back up and
+    // the store waits. Otherwise pick up the game saved before the
+    // last reset and serve.
+    resumed = resumeGame();
+    if (!resumed) {
+        storeInit();
+        restoreGame();
+    }
+    bootMark(BOOT_RESTORE);
+
+    if (!resumed)
+        serve();
+
+    // Enter the saved mode (sets the user LED)
+    activeMode = &gameModes[led_mode];
+    activeMode->enter();
+    bootMark(BOOT_FIRST_FRAME);
+
+    // --- Deferred: nothing below is needed to show the first frame ---
+    stackPaint();       // high-water marks start here (emu/pong.resc times it)
+    if (resumed)
+        storeInit();    // saves need it; the values are the image's already
+
+    init_Matrix();      // 8x8 matrix, refreshed by SPI2 + DMA
+
+    // Start handler execution time tracking
+    wcetInit();
+
+    // Input first, then time base, then the PendSV bottom half
+    configureInterruptPriorities();
+
+    // LED brightness: BAM on TIM7, PWM on TIM4 (trail and score pulse)
+    init_Brightness();
+    redrawLeds();       // the engine starts dark; show the frame again
+
+    // Timestamped button edges (EXTI + TIM5)
+    init_Capture();
+
+    // 4x4 key matrix (TIM15 row scan); scanned and debounced, not read yet
+    init_Keypad();
+
+    // Analog paddles for spin (ADC1 + DMA, runs on its own)
+    init_Analog();
+
+    // USART1 link to a second board for NET_MODE
+    init_Link();
+
+    // Sound effects on PA4 (DAC1 + TIM6 + DMA, no CPU while playing)
+    init_Sound();
+#ifdef WCET_BENCH
+    runWcetBench();     // after init_Sound()/init_Link(): the cues and packets it sends are real
+#endif
+    bootMark(BOOT_DEFERRED);
 
     // Configure system timers
-    configureSysTick(currentSpeed);  // Start SysTick for gameplay speed
+    init_Tickless();
+    startModeClock();                // SysTick rate, or the first tickless event
+#ifdef INPUT_TIM2
     configureTimer();                // Timer2 handles button debouncing
+#else
+    init_Sampler();                  // TIM16 + DMA sample the buttons
+#endif
+    bootMark(BOOT_RUNNING);
 
-    // Set initial serve state
-    serve();
+    // The main loop: input, store and stats tasks (TIM5 wakes the core)
+    schedInit(tasks, NUM_TASKS);
+    schedRun();
+}
 
-    // Set user LED (PA5) depending on initial mode
-    if (led_mode == PLAY_MODE)
-        GPIOA->ODR |= GPIO_ODR_OD5;   // Turn ON user LED for play mode
-    else
-        GPIOA->ODR &= ~GPIO_ODR_OD5;  // Turn OFF for flash mode
+/*****************************************************************************
+ * inputTask()
+ * @param None
+ * @return None
+ * Every INPUT_PERIOD_MS: a user button release steps to the next
+ * mode, then the mode's own input hook runs. Releasing the press
+ * that woke the board from Standby does not count.
+ *****************************************************************************/
+static void inputTask(void)
+{
+    static uint8_t prevUserBtn = 1;
+    uint8_t currUserBtn = (GPIOC->IDR & (1 << 13)) != 0;
 
-    // Variables to track user button state for rising edge detection
-    uint8_t prevUserBtn = 1;
-    uint8_t currUserBtn;
+    // Rising edge (button release): next mode
+    if (prevUserBtn == 0 && currUserBtn == 1 && !wakePress)
+        switchMode((led_mode + 1) % NUM_MODES);
+    if (currUserBtn)
+        wakePress = 0;
+    prevUserBtn = currUserBtn;
 
-    while (1)
-    {
-        // Read current user button state (PC13)
-        if ((GPIOC->IDR & (1 << 13)) != 0)
-            currUserBtn = 1;
-        else
-            currUserBtn = 0;
+    activeMode->input();
+}
 
-        // Check for rising edge (button release)
-        if (prevUserBtn == 0 && currUserBtn == 1)
-        {
-            // Toggle between PLAY_MODE and FLASH_LED_MODE
-            if (led_mode == PLAY_MODE)
-            {
-                led_mode = FLASH_LED_MODE;
+/*****************************************************************************
+ * storeTask()
+ * @param None
+ * @return None
+ * Background flash writes for the store (never waits). Runs every
+ * STORE_PERIOD_MS, and at once when saveGame() posts it.
+ *****************************************************************************/
+static void storeTask(void)
+{
+    storeService();
+}
 
-                // Indicate mode change by turning OFF user LED
-                GPIOA->ODR &= ~GPIO_ODR_OD5;
+/*****************************************************************************
+ * statsTask()
+ * @param None
+ * @return None
+ * Once a second: which handlers have gone over their WCET budget,
+ * how deep the thread and handler stacks have been (stackUse[]), and
+ * in DEBOUNCE_BENCH builds the recorded debounce profile.
+ * Read wcetAlarms, wcet[], schedStats[], stackUse[] and the pools
+ * (poolFirst list, pool.h) from the debugger.
+ *****************************************************************************/
+static void statsTask(void)
+{
+    wcetAlarms = wcetCheckBudgets();
+    stackCheck();
+#ifdef DEBOUNCE_BENCH
+    debounceBenchService();     // the recorded button, once it is captured
+#endif
+}
 
-                // Clear all playfield LEDs
-                GPIOC->ODR &= ~(0xFF << 5);
+/*****************************************************************************
+ * loadTask()
+ * @param None
+ * @return None
+ * Closes a CPU load window every LOAD_WINDOW_MS (load.c). Query the
+ * result with loadRead(), or watch it in DIAG_MODE.
+ *****************************************************************************/
+static void loadTask(void)
+{
+    loadUpdate();
+}
 
-                // Start flash mode from leftmost LED
-                setLedPattern(0x01);
+/*****************************************************************************
+ * standbyTask()
+ * @param None
+ * @return None
+ * Between matches (PLAY_MODE waiting for a serve) with no button edge
+ * for STANDBY_IDLE_MS and nothing left to write to flash, the board
+ * goes to Standby with the game in retained SRAM2. The user button
+ * wakes it, and resumeGame() shows the same frame again.
+ *****************************************************************************/
+static void standbyTask(void)
+{
+    StandbyImage image;
 
-                // Set smooth, fast SysTick speed for flash mode
-                configureSysTick(FLASH_MODE_SPEED);
-            }
-            else
-            {
-                led_mode = PLAY_MODE;
+    if (led_mode != PLAY_MODE || gameState != STATE_SERVE || !storeIdle())
+        return;
+    if (TIME_DIFF(captureNow(), lastInput) < (int32_t)(STANDBY_IDLE_MS * 4000))
+        return;
 
-                // Turn ON user LED to indicate play mode
-                GPIOA->ODR |= GPIO_ODR_OD5;
+    image.speed = currentSpeed;
+    image.state = gameState;
+    image.scores = (uint8_t)(player1Score | (player2Score << 2));
+    image.server = currentServer;
+    image.pattern = ledPattern;
+    standbyEnter(&image);
+}
 
-                // Restore normal game tick speed
-                configureSysTick(currentSpeed);
-            }
-        }
+/*****************************************************************************
+ * timersTask()
+ * @param None
+ * @return None
+ * Runs the software timer callbacks (swtimer.c), e.g. the winner flash.
+ * It has no period: swtimer.c books the next run through timerWake().
+ *****************************************************************************/
+static void timersTask(void)
+{
+    timerService();
+}
 
-        // Store current state for next comparison
-        prevUserBtn = currUserBtn;
+/*****************************************************************************
+ * timerWake()
+ * @param due - TIM5 count the next software timer is due at
+ * @return None
+ *****************************************************************************/
+void timerWake(uint32_t due)
+{
+    schedPostAt(TASK_TIMERS, due);
+}
 
-        // Handle LED shifting logic in FLASH_LED_MODE
-        if (led_mode == FLASH_LED_MODE)
-        {
-            handleFlashLedMode();
-        }
+/*****************************************************************************
+ * startModeClock()
+ * @param None
+ * @return None
+ * Starts the active mode's time base: SysTick at its period, or for
+ * a tickless mode SysTick off and one tick right away, which arms
+ * the mode's first event.
+ *****************************************************************************/
+static void startModeClock(void)
+{
+    if (activeMode->tickPeriod) {
+        ticklessDisarm();
+        configureSysTick(*activeMode->tickPeriod);
+    }
+    else {
+        SysTick->CTRL = 0;
+        deferToPendSV();
     }
 }
 
+/*****************************************************************************
+ * samplerEdge()
+ * @param button - BTN_* index
+ * @return None
+ * Called by the input interrupt on every debounced edge. A tickless
+ * mode gets a tick for it, so presses need no polling. Any edge also
+ * holds off Standby.
+ *****************************************************************************/
+RAMFUNC void samplerEdge(uint8_t button)
+{
+    (void)button;
+
+    lastInput = captureNow();
+
+    if (!activeMode->tickPeriod)
+        deferToPendSV();
+}
+
 /*****************************************************************************
  * configureSysTick()
  * @parameter: reloadValue - The reload value determining the speed ticks.
  * @return None
  * Configures the SysTick timer for the game speed.
+ * The new period also becomes the reference for tick jitter.
  ******************************************************************************/
 void configureSysTick(uint32_t reloadValue)
 {
+    irqStatsSetPeriod(IRQ_STAT_SYSTICK, reloadValue);
+
     SysTick->LOAD  = reloadValue - 1;
     SysTick->VAL   = 0;
     SysTick->CTRL  = SysTick_CTRL_CLKSOURCE_Msk |
@@ -148,6 +524,7 @@ void configureSysTick(uint32_t reloadValue)
                      SysTick_CTRL_ENABLE_Msk;
 }
 
+#ifdef INPUT_TIM2
 /***********************************************************************
  * @ConfigureTimer()
  * @param None
@@ -164,6 +541,7 @@ void configureTimer(void)
     TIM2->ARR = 19;
     TIM2->DIER |= TIM_DIER_UIE;
     TIM2->CR1 |= TIM_CR1_CEN;
+    irqStatsSetPeriod(IRQ_STAT_INPUT, (2999 + 1) * (19 + 1));
     NVIC_EnableIRQ(TIM2_IRQn);
 }
 
@@ -172,152 +550,658 @@ void configureTimer(void)
  * @param None
  * @return None
  * Timer 2 interrupt handles button debouncing. 
- * The decouncer 
+ * The decouncer runs from SRAM (RAMFUNC) so flash wait states
+ * never stretch it. Only built with INPUT_TIM2 (targets without the
+ * DMA sampler, e.g. the Renode machine); sampler.c does this otherwise.
  ******************************************************/
-void TIM2_IRQHandler(void)
+RAMFUNC void TIM2_IRQHandler(void)
 {
+    uint32_t start = WCET_START();
+
+    // Latency only to one prescaled count (PSC + 1 cycles)
+    irqStatsEntry(IRQ_STAT_INPUT, TIM2->CNT * (TIM2->PSC + 1));
+
     if (TIM2->SR & TIM_SR_UIF)
     {
         TIM2->SR &= ~TIM_SR_UIF;
 
         for (int i = 0; i < NUM_BUTTONS; i++) {
             buttons[i].filter <<= 1U;
-            if (buttons[i].port->IDR & (1U << buttons[i].pin))
+            if (BUTTON_PORT->IDR & (1U << buttons[i].pin))
                 buttons[i].filter |= 1U;
 
-            buttons[i].filter &= 0xFF;
-
             switch (buttons[i].filter) {
-                case 0x00: buttons[i].state = 0; break;
-                case 0xFF: buttons[i].state = 1; break;
+                case 0x00:
+                    if (buttons[i].state) { buttons[i].state = 0; samplerEdge(i); }
+                    break;
+                case 0xFF:
+                    if (!buttons[i].state) { buttons[i].state = 1; samplerEdge(i); }
+                    break;
                 default: break;
             }
         }
     }
+
+    wcetStop(WCET_INPUT, start);
 }
+#endif
 
 /***************************************************************
  * Systick_Handler()
  * @param None
  * @return None
- * SysTick interrupt handler for game state progression.
+ * SysTick interrupt handler: the game time base.
+ * Measures its own latency (cycles since reload) and hands the game
+ * step to PendSV, so a long step never delays the next tick. A step
+ * still unfinished at this point counts as a tick overrun.
+ *************************************************************/
+RAMFUNC void SysTick_Handler(void)
+{
+    uint32_t start = WCET_START();
+
+    irqStatsEntry(IRQ_STAT_SYSTICK, SysTick->LOAD - SysTick->VAL);
+
+    irqTickDefer(IRQ_STAT_SYSTICK);
+
+    wcetStop(WCET_SYSTICK, start);
+}
+
+/***************************************************************
+ * PendSV_Handler()
+ * @param None
+ * @return None
+ * Bottom half of the game tick: runs the current mode's tick hook.
+ * Runs from SRAM (RAMFUNC), as do the LED functions it calls.
+ *************************************************************/
+RAMFUNC void PendSV_Handler(void)
+{
+    uint32_t start = WCET_START();
+
+    irqDeferredEntry();
+    activeMode->tick();
+
+    wcetStop(WCET_PENDSV, start);
+}
+
+/***************************************************************
+ * playTick()
+ * @param None
+ * @return None
+ * PLAY_MODE event: the Pong state machine and LED commits. Runs
+ * when the ball step armed last time is due, or on a button edge
+ * (samplerEdge()), never on a fixed tick. While the ball sits on a
+ * paddle its next step is also the close of the hit window, so one
+ * armed time covers both. Hits and misses are settled in the same
+ * event that finds them instead of on the next tick.
+ *************************************************************/
+static RAMFUNC void playTick(void)
+{
+    uint32_t now = captureNow();
+
+    while (playStep(now))
+        ; // hits and misses run on in the same event
+
+    // Next wake-up: the ball step, a poll of the winner flash, or
+    // (serving) only the server's button. A server already holding it,
+    // e.g. after an early press missed, serves on the next tick as in
+    // the SysTick modes instead of waiting for a new press.
+    if (gameState == STATE_SHIFT_LEFT || gameState == STATE_SHIFT_RIGHT)
+        ticklessArm(stepAt);
+    else if (gameState == STATE_WIN)
+        ticklessArm(now + WIN_POLL);
+    else if (gameState == STATE_SERVE &&
+             buttons[currentServer == 1 ? BTN_LEFT : BTN_RIGHT].state == 0)
+        ticklessArm(now + currentSpeed);
+    else
+        ticklessDisarm();
+}
+
+/***************************************************************
+ * playStep()
+ * @param now - TIM5 count of this event
+ * @return 1 if the new state has to run in this event too
+ * One pass of the PLAY_MODE state machine.
  *************************************************************/
-void SysTick_Handler(void)
+static RAMFUNC uint8_t playStep(uint32_t now)
 {
-    msTimer++;
+    uint8_t again = 0;
 
     // State machine logic
-    if (led_mode == PLAY_MODE)
+    switch (gameState) // state machine
     {
-        switch (gameState) // state machine
+    case STATE_SERVE: // begin serve
+        serve(); // call serve function
+
+        // Wait for current server to press their respective button
+        if ((currentServer == 1 && buttons[BTN_LEFT].state == 0) ||
+            (currentServer == 0 && buttons[BTN_RIGHT].state == 0)) 
         {
-        case STATE_SERVE: // begin serve
-            serve(); // call serve function
-
-            // Wait for current server to press their respective button
-            if ((currentServer == 1 && buttons[BTN_LEFT].state == 0) ||
-                (currentServer == 0 && buttons[BTN_RIGHT].state == 0)) 
-            {
-                if (ledPattern == 0x01) // If at player 1's paddle, shift left
-                    gameState = STATE_SHIFT_LEFT;
-                else if (ledPattern == 0x80) // if at player 2's paddle, shift right
-                    gameState = STATE_SHIFT_RIGHT;
-            }
-            break;
+            if (ledPattern == 0x01) // If at player 1's paddle, shift left
+                gameState = STATE_SHIFT_LEFT;
+            else if (ledPattern == 0x80) // if at player 2's paddle, shift right
+                gameState = STATE_SHIFT_RIGHT;
+            stepAt = now + currentSpeed;
+        }
+        break;
 
-        case STATE_SHIFT_LEFT:
-            if (buttons[BTN_RIGHT].state == 0) // check if the right button was pressed
-            {
-                if (ledPattern == 0x80)
-                    gameState = STATE_RIGHT_HIT; // if button is hit on paddle, it bounces back.
-                else if (ledPattern == 0x40)
-                    gameState = STATE_RIGHT_MISS; // if pressed early it's a miss
-                // Other values are ignored
-            }
-            else if (!shiftLeft()) // if we can't shift further, it's a miss
-            {
-                gameState = STATE_RIGHT_MISS; // ball passed player 2
-            }
-            break;
+    case STATE_SHIFT_LEFT:
+        if (buttons[BTN_RIGHT].state == 0 && ledPattern == 0x80)
+            gameState = STATE_RIGHT_HIT; // if button is hit on paddle, it bounces back.
+        else if (buttons[BTN_RIGHT].state == 0 && ledPattern == 0x40)
+            gameState = STATE_RIGHT_MISS; // if pressed early it's a miss
+        else if (TIME_DIFF(now, stepAt) < 0)
+            break; // a button edge between steps: nothing due
+        else if (buttons[BTN_RIGHT].state == 0)
+            ; // pressed anywhere else: the ball holds for this step
+        else if (!shiftLeft()) // if we can't shift further, it's a miss
+            gameState = STATE_RIGHT_MISS; // ball passed player 2
+        else if (ledPattern == 0x80)
+            paddleArrival = stepAt; // ball just reached player 2
+        again = (gameState != STATE_SHIFT_LEFT);
+        nextStep(now);
+        break;
 
-        case STATE_SHIFT_RIGHT:
-            if (buttons[BTN_LEFT].state == 0) // check if left button was pressed.
-            {
-                if (ledPattern == 0x01)
-                    gameState = STATE_LEFT_HIT; // if button is hit on paddle, it bounces back.
-                else if (ledPattern == 0x02)
-                    gameState = STATE_LEFT_MISS; // if pressed early it's a miss
-                // Other values are ignored
-            }
-            else if (!shiftRight()) // if we can't shift further, it's a miss
-            {
-                gameState = STATE_LEFT_MISS; // ball passed player 1
-            }
-            break;
+    case STATE_SHIFT_RIGHT:
+        if (buttons[BTN_LEFT].state == 0 && ledPattern == 0x01)
+            gameState = STATE_LEFT_HIT; // if button is hit on paddle, it bounces back.
+        else if (buttons[BTN_LEFT].state == 0 && ledPattern == 0x02)
+            gameState = STATE_LEFT_MISS; // if pressed early it's a miss
+        else if (TIME_DIFF(now, stepAt) < 0)
+            break; // a button edge between steps: nothing due
+        else if (buttons[BTN_LEFT].state == 0)
+            ; // pressed anywhere else: the ball holds for this step
+        else if (!shiftRight()) // if we can't shift further, it's a miss
+            gameState = STATE_LEFT_MISS; // ball passed player 1
+        else if (ledPattern == 0x01)
+            paddleArrival = stepAt; // ball just reached player 1
+        again = (gameState != STATE_SHIFT_RIGHT);
+        nextStep(now);
+        break;
 
-        case STATE_RIGHT_HIT:
-            if (currentSpeed > MAX_SPEED_TICKS + SPEED_STEP)
-                currentSpeed -= SPEED_STEP; // make it faster
-            configureSysTick(currentSpeed); // apply new speed
-            gameState = STATE_SHIFT_RIGHT; // bounce back to player 1
-            break;
+    case STATE_RIGHT_HIT:
+        reactionTime[1] = (int32_t)(captureLastPress(BTN_RIGHT) - paddleArrival);
+        if (currentSpeed > MAX_SPEED_TICKS + SPEED_STEP)
+            currentSpeed -= SPEED_STEP; // make it faster
+        applySpin(ANALOG_PADDLE_RIGHT); // player 2's paddle adds spin
+        soundPlay(SOUND_HIT);
+        stepAt = now + currentSpeed; // apply new speed from the hit on
+        gameState = STATE_SHIFT_RIGHT; // bounce back to player 1
+        break;
 
-        case STATE_LEFT_HIT:
-            if (currentSpeed > MAX_SPEED_TICKS + SPEED_STEP)
-                currentSpeed -= SPEED_STEP;
-            configureSysTick(currentSpeed); // Increase the game speed
-            gameState = STATE_SHIFT_LEFT; // bounce back to player 2
-            break;
+    case STATE_LEFT_HIT:
+        reactionTime[0] = (int32_t)(captureLastPress(BTN_LEFT) - paddleArrival);
+        if (currentSpeed > MAX_SPEED_TICKS + SPEED_STEP)
+            currentSpeed -= SPEED_STEP;
+        applySpin(ANALOG_PADDLE_LEFT);
+        soundPlay(SOUND_HIT);
+        stepAt = now + currentSpeed; // Increase the game speed
+        gameState = STATE_SHIFT_LEFT; // bounce back to player 2
+        break;
 
-        case STATE_RIGHT_MISS:
-            player1Score++; // player 1 gets a point
-            updatePlayerScore(player1Score, 1);
-            if (player1Score >= 3) {
-                gameState = STATE_WIN; // check if player 1 wins
-                break;
-            }
-            currentSpeed = INITIAL_SPEED; // reset speed
-            configureSysTick(currentSpeed);
-            currentServer = 0; // switch to player 2 serving
-            serve(); // new serve
-            gameState = STATE_SERVE;
+    case STATE_RIGHT_MISS:
+        player1Score++; // player 1 gets a point
+        updatePlayerScore(player1Score, 1);
+        soundPlay(SOUND_MISS);
+        if (player1Score >= 3) {
+            soundPlay(SOUND_WIN);
+            coroInit(&winCo);
+            gameState = STATE_WIN; // check if player 1 wins
+            again = 1;
             break;
+        }
+        currentSpeed = INITIAL_SPEED; // reset speed
+        currentServer = 0; // switch to player 2 serving
+        serve(); // new serve
+        saveGame();
+        gameState = STATE_SERVE;
+        break;
 
-        case STATE_LEFT_MISS:
-            player2Score++; // player 2 gets a point
-            updatePlayerScore(player2Score, 2);
-            if (player2Score >= 3) {
-                gameState = STATE_WIN; // check if player 2 wins
-                break;
-            }
-            currentSpeed = INITIAL_SPEED; // reset speed
-            configureSysTick(currentSpeed);
-            currentServer = 1; // switch to player 1 serving
-            serve(); // new serve
-            gameState = STATE_SERVE;
+    case STATE_LEFT_MISS:
+        player2Score++; // player 2 gets a point
+        updatePlayerScore(player2Score, 2);
+        soundPlay(SOUND_MISS);
+        if (player2Score >= 3) {
+            soundPlay(SOUND_WIN);
+            coroInit(&winCo);
+            gameState = STATE_WIN; // check if player 2 wins
+            again = 1;
             break;
+        }
+        currentSpeed = INITIAL_SPEED; // reset speed
+        currentServer = 1; // switch to player 1 serving
+        serve(); // new serve
+        saveGame();
+        gameState = STATE_SERVE;
+        break;
 
-        case STATE_WIN:
-            if (player1Score >= 3)
-                flashWinnerScore(1); // flash winning LEDs for player 1
-            else if (player2Score >= 3)
-                flashWinnerScore(2); // flash winning LEDs for player 2
-
-            // Reset Pong game
-            player1Score = 0;
-            player2Score = 0;
-            updatePlayerScore(0, 1);
-            updatePlayerScore(0, 2);
-            currentSpeed = INITIAL_SPEED;
-            configureSysTick(currentSpeed);
-            currentServer = 1;
-            serve(); // return to beginning state
+    case STATE_WIN:
+        if (winFlow(&winCo) == CORO_DONE)
             gameState = STATE_SERVE;
-            break;
+        break;
+    }
+    return again;
+}
+
+/***************************************************************
+ * nextStep()
+ * @param now - TIM5 count of this event
+ * @return None
+ * Advances stepAt past a step that was due. An event that came so
+ * late that the next step is due as well starts the pace over from
+ * now instead of catching up with back-to-back steps.
+ *************************************************************/
+static RAMFUNC void nextStep(uint32_t now)
+{
+    if (TIME_DIFF(now, stepAt) < 0)
+        return; // settled by a button edge, the step still stands
+
+    stepAt += currentSpeed;
+    if (TIME_DIFF(now, stepAt) >= 0)
+        stepAt = now + currentSpeed;
+}
+
+/***************************************************************
+ * winFlow()
+ * @param co - coroutine state (winCo)
+ * @return CORO_RUNNING until the new game is set up
+ * STATE_WIN as one flow: flash the winner's score, wait for the
+ * flash without holding up the tick, then reset the game.
+ *************************************************************/
+static RAMFUNC uint8_t winFlow(Coro *co)
+{
+    CORO_BEGIN(co);
+
+    flashWinnerScore(player1Score >= 3 ? 1 : 2);
+    CORO_AWAIT_UNTIL(co, !flashWinnerBusy());
+
+    // Reset Pong game
+    player1Score = 0;
+    player2Score = 0;
+    updatePlayerScore(0, 1);
+    updatePlayerScore(0, 2);
+    currentSpeed = INITIAL_SPEED;
+    currentServer = 1;
+    serve(); // return to beginning state
+    saveGame();
+
+    CORO_END(co);
+}
+
+/*****************************************************************************
+ * switchMode()
+ * @param mode - index into gameModes[]
+ * @return None
+ * Leaves the current mode, swaps the descriptor and applies the new
+ * mode's tick period and entry hook. Called from the input task.
+ * A winner flash of the old mode is cut short.
+ *****************************************************************************/
+static void switchMode(uint8_t mode)
+{
+    flashWinnerScore(0);
+    activeMode->exit();
+
+    led_mode = mode;
+    activeMode = &gameModes[mode];
+    activeMode->enter();
+    startModeClock();
+
+    saveGame();
+}
+
+/*****************************************************************************
+ * playEnter() / flashEnter() / noModeHook()
+ * @param None
+ * @return None
+ * Mode hooks. The user LED is on in PLAY_MODE and off in
+ * FLASH_LED_MODE, which starts from the leftmost LED.
+ *****************************************************************************/
+static void playEnter(void)
+{
+    GPIOA->ODR |= GPIO_ODR_OD5;   // Turn ON user LED for play mode
+    stepAt = captureNow() + currentSpeed;  // a rally resumes at its pace
+}
+
+static void playExit(void)
+{
+    ticklessDisarm();
+}
+
+static void flashEnter(void)
+{
+    GPIOA->ODR &= ~GPIO_ODR_OD5;  // Turn OFF for flash mode
+    setLedPattern(0x01);          // Start flash mode from leftmost LED
+}
+
+static RAMFUNC void noModeHook(void)
+{
+}
+
+/*****************************************************************************
+ * multiballEnter() / multiballExit()
+ * @param None
+ * @return None
+ * MULTIBALL_MODE keeps its own score on the score LEDs; leaving it
+ * clears the matrix and shows the PLAY_MODE game again.
+ *****************************************************************************/
+static void multiballEnter(void)
+{
+    GPIOA->ODR |= GPIO_ODR_OD5;
+    multiballClear(&court);
+    multiWinner = 0;
+    for (int p = 0; p < 2; p++) {
+        swingTicks[p] = 0;
+        paddleHeld[p] = 0;
+        multiScore[p] = 0;
+    }
+    updatePlayerScore(0, 1);
+    updatePlayerScore(0, 2);
+}
+
+static void multiballExit(void)
+{
+    matrixClear();
+    redrawLeds();
+}
+
+/*****************************************************************************
+ * drawCourt()
+ * @param None
+ * @return None
+ * Lane n goes to matrix row n; the court row also drives PC5-PC12.
+ *****************************************************************************/
+static RAMFUNC void drawCourt(void)
+{
+    uint64_t balls = multiballOccupied(&court);
+
+    for (int row = 0; row < MATRIX_ROWS; row++)
+        matrixSetRow(row, (uint8_t)(balls >> (row * 8)));
+    setLedPattern((uint8_t)(balls >> (MATRIX_COURT_ROW * 8)));
+}
+
+/*****************************************************************************
+ * multiballTick()
+ * @param None
+ * @return None
+ * MULTIBALL_MODE tick. A new press swings the paddle for
+ * MULTIBALL_SWING ticks, and every ball reaching it meanwhile comes
+ * back. Each return launches another ball from that paddle in the
+ * next lane. A ball that passes a player scores for the other one.
+ * The court step costs the same for any number of balls.
+ *****************************************************************************/
+static RAMFUNC void multiballTick(void)
+{
+    MultiballEvents events;
+    uint8_t held[2] = { buttons[BTN_LEFT].state == 0, buttons[BTN_RIGHT].state == 0 };
+
+    // Round over: the court stays frozen until the flash ends
+    if (multiWinner) {
+        if (flashWinnerBusy())
+            return;
+        multiballEnter();                      // new round
+    }
+
+    for (int p = 0; p < 2; p++) {
+        if (held[p] && !paddleHeld[p])
+            swingTicks[p] = MULTIBALL_SWING;
+        paddleHeld[p] = held[p];
+    }
+
+    multiballStep(&court, swingTicks[0] != 0, swingTicks[1] != 0, &events);
+
+    for (int p = 0; p < 2; p++) {
+        if (swingTicks[p])
+            swingTicks[p]--;
+        if (events.returned[p])
+            soundPlay(SOUND_HIT);
+        if (events.returned[p] && multiballCount(&court) < MULTIBALL_MAX)
+            multiballLaunch(&court, p + 1, nextLane++);
+    }
+
+    if (events.passed[0] || events.passed[1]) {
+        multiScore[0] += events.passed[1];     // balls past player 2
+        multiScore[1] += events.passed[0];
+        updatePlayerScore(multiScore[0], 1);
+        updatePlayerScore(multiScore[1], 2);
+        soundPlay(SOUND_MISS);
+
+        if (multiScore[0] >= 3 || multiScore[1] >= 3) {
+            multiWinner = multiScore[0] >= 3 ? 1 : 2;
+            soundPlay(SOUND_WIN);
+            flashWinnerScore(multiWinner);     // new round when it ends
+            return;
+        }
+    }
+
+    // Empty court: the current server launches on the court row
+    if (multiballOccupied(&court) == 0)
+        multiballLaunch(&court, currentServer ? 1 : 2, MATRIX_COURT_ROW);
+
+    drawCourt();
+}
+
+/*****************************************************************************
+ * netEnter() / netExit()
+ * @param None
+ * @return None
+ * Starts a new linked session at tick 0 under a new id. Ticks start
+ * once the other board answers; if that board was still in an older
+ * session it starts over with this one, so the boards can be switched
+ * over in any order and either can leave NET_MODE or reset.
+ *****************************************************************************/
+static void netEnter(void)
+{
+    GPIOA->ODR |= GPIO_ODR_OD5;
+    netSessionInit(&netSession, NET_LOCAL_PLAYER - 1, (uint16_t)captureNow());
+    netShown[0] = 0;
+    netShown[1] = 0;
+    updatePlayerScore(0, 1);
+    updatePlayerScore(0, 2);
+}
+
+static void netExit(void)
+{
+    redrawLeds();
+}
+
+/*****************************************************************************
+ * netTick()
+ * @param None
+ * @return None
+ * NET_MODE tick. Takes the other board's packets, runs one lockstep
+ * tick with this board's paddle (either button), sends this board's
+ * inputs, and draws this board's half of the court. A rollback in
+ * netSessionReceive() only changes what is drawn here. The ball is
+ * drawn from the predicted game, the scores and wins from the settled
+ * one, so a rollback never takes a point or a win back. The game
+ * goes on during a winner flash; only the score LEDs wait for it.
+ *****************************************************************************/
+static RAMFUNC void netTick(void)
+{
+    uint8_t packet[LINK_MAX_PAYLOAD];
+    uint8_t len;
+    const NetGame *game = &netSession.game;
+    const NetGame *settled;
+    uint8_t winner;
+    int8_t cell;
+
+    while ((len = linkPoll(packet)) != 0)
+        netSessionReceive(&netSession, packet, len);
+
+    netSessionAdvance(&netSession,
+                      buttons[BTN_LEFT].state == 0 || buttons[BTN_RIGHT].state == 0);
+    linkSend(packet, netSessionPacket(&netSession, packet));
+
+    // Cells 0-7 on player 1's board, 8-15 on player 2's
+    cell = game->pos - (NET_LOCAL_PLAYER - 1) * 8;
+    setLedPattern((cell >= 0 && cell < 8) ? (uint8_t)(1u << cell) : 0);
+
+    // The game has already reset the scores on a win: flash the 3,
+    // then show the new scores once the flash is over
+    winner = netSessionTakeWin(&netSession);
+    if (winner) {
+        updatePlayerScore(NET_WIN_SCORE, winner);
+        flashWinnerScore(winner);
+        netShown[winner - 1] = NET_WIN_SCORE;
+    }
+    if (flashWinnerBusy())
+        return;
+
+    settled = netSessionSettled(&netSession);
+    for (int p = 0; p < 2; p++) {
+        if (settled->score[p] != netShown[p]) {
+            netShown[p] = settled->score[p];
+            updatePlayerScore(netShown[p], p + 1);
         }
     }
 }
 
+/*****************************************************************************
+ * diagEnter() / diagExit()
+ * @param None
+ * @return None
+ * DIAG_MODE borrows the playfield and score LEDs; the game's LEDs
+ * come back on exit.
+ *****************************************************************************/
+static void diagEnter(void)
+{
+    GPIOA->ODR &= ~GPIO_ODR_OD5;
+    diagSavedPattern = getCurrentLedPattern();
+}
+
+static void diagExit(void)
+{
+    setLedPattern(diagSavedPattern);
+    redrawLeds();
+}
+
+/*****************************************************************************
+ * diagTick()
+ * @param None
+ * @return None
+ * DIAG_MODE tick: CPU load of the last window as a bar on the eight
+ * playfield LEDs (one LED per 12.5 %, any load lights the first), and
+ * on player 1's score LEDs how many tick faults (late, missed or
+ * overrun ticks) that window had, up to 3.
+ *****************************************************************************/
+static RAMFUNC void diagTick(void)
+{
+    LoadReport load;
+    uint32_t leds;
+
+    loadRead(&load);
+
+    leds = (load.loadPermille * 8 + 999) / 1000;
+    setLedPattern((uint8_t)((1u << leds) - 1));
+    updatePlayerScore(load.windowFaults > 3 ? 3 : (uint8_t)load.windowFaults, 1);
+    updatePlayerScore(0, 2);
+}
+
+/*****************************************************************************
+ * applySpin()
+ * @param paddle - ANALOG_PADDLE_LEFT or ANALOG_PADDLE_RIGHT
+ * @return None
+ * Speeds up the return by up to SPIN_MAX ticks, in proportion to how
+ * far the hitting player's analog paddle is turned. Never goes past
+ * MAX_SPEED_TICKS.
+ *****************************************************************************/
+static void applySpin(uint8_t paddle)
+{
+    AnalogSnapshot analog;
+    analogRead(&analog);
+
+    uint32_t spin = ((uint32_t)analog.paddle[paddle] * SPIN_MAX) / ANALOG_MAX;
+
+    if (currentSpeed > MAX_SPEED_TICKS + spin)
+        currentSpeed -= spin;
+    else
+        currentSpeed = MAX_SPEED_TICKS;
+}
+
+/*****************************************************************************
+ * saveGame()
+ * @param None
+ * @return None
+ * Hands the game settings to the store. Only RAM is touched here;
+ * the store task (storeService()) writes the changes to flash.
+ *****************************************************************************/
+static void saveGame(void)
+{
+    storeSet(STORE_KEY_P1_SCORE, player1Score);
+    storeSet(STORE_KEY_P2_SCORE, player2Score);
+    storeSet(STORE_KEY_SERVER, currentServer);
+    storeSet(STORE_KEY_SPEED, currentSpeed);
+    storeSet(STORE_KEY_MODE, led_mode);
+    schedPost(TASK_STORE);
+}
+
+/*****************************************************************************
+ * restoreGame()
+ * @param None
+ * @return None
+ * Loads what saveGame() stored before the reset. Values that are out
+ * of range are ignored, so a blank store gives the normal start.
+ *****************************************************************************/
+static void restoreGame(void)
+{
+    uint32_t value;
+
+    if (storeGet(STORE_KEY_P1_SCORE, &value) && value < 3)
+        player1Score = value;
+    if (storeGet(STORE_KEY_P2_SCORE, &value) && value < 3)
+        player2Score = value;
+    if (storeGet(STORE_KEY_SERVER, &value) && value <= 1)
+        currentServer = value;
+    if (storeGet(STORE_KEY_SPEED, &value) &&
+        value >= MAX_SPEED_TICKS && value <= INITIAL_SPEED)
+        currentSpeed = value;
+    if (storeGet(STORE_KEY_MODE, &value) && value < NUM_MODES)
+        led_mode = value;
+
+    updatePlayerScore(player1Score, 1);
+    updatePlayerScore(player2Score, 2);
+}
+
+/*****************************************************************************
+ * resumeGame()
+ * @param None
+ * @return 1 = woken from Standby and the frame is back, 0 = normal start
+ * Puts the game standbyTask() kept back as it was, straight onto the
+ * LEDs. Only PLAY_MODE sleeps, so that is the mode it resumes in.
+ *****************************************************************************/
+static uint8_t resumeGame(void)
+{
+    StandbyImage image;
+
+    if (!standbyResume(&image))
+        return 0;
+
+    currentSpeed = image.speed;
+    gameState = (PongState)image.state;
+    player1Score = image.scores & 0x3;
+    player2Score = (image.scores >> 2) & 0x3;
+    currentServer = image.server;
+    ledPattern = image.pattern;
+    led_mode = PLAY_MODE;
+    wakePress = 1;
+
+    redrawLeds();
+    return 1;
+}
+
+/*****************************************************************************
+ * redrawLeds()
+ * @param None
+ * @return None
+ * Commits the playfield and both scores again, e.g. after the LED
+ * driver changed.
+ *****************************************************************************/
+static void redrawLeds(void)
+{
+    update_LEDs_PC5to12();
+    updatePlayerScore(player1Score, 1);
+    updatePlayerScore(player2Score, 2);
+}
+
 /*****************************************************************************
  * handleFlashLedMode(void)
  * @param None
@@ -354,3 +1238,94 @@ void handleFlashLedMode(void)
     prevLeftBtn = currLeftBtn;
     prevRightBtn = currRightBtn; // update the values for the buttons
 }
+
+#ifdef WCET_BENCH
+/*****************************************************************************
+ * runWcetBench(void)
+ * @param None
+ * @return None
+ * Calls SysTick_Handler and PendSV_Handler for every PongState in every
+ * mode, at both paddles and mid-court, with the buttons held and
+ * released. TIM2_IRQHandler is called with a pending update each time
+ * (INPUT_TIM2), or the sampler runs its worst-case batches once.
+ * Interrupts are masked so the PendSV pended by SysTick_Handler does not
+ * run on its own. Game state is reset afterwards. Runs after init_Sound()
+ * and init_Link(), so the sound and link writes it times go to clocked
+ * peripherals; the last cue it started plays out once interrupts are back.
+ * If any handler's worst case is over budget the bench halts here:
+ * check wcet[] in the debugger.
+ *****************************************************************************/
+static void runWcetBench(void)
+{
+    static const uint8_t modes[] = { PLAY_MODE, FLASH_LED_MODE, MULTIBALL_MODE, NET_MODE,
+                                     DIAG_MODE };
+    static const uint8_t patterns[] = { 0x01, 0x02, 0x40, 0x80 };
+
+#ifdef INPUT_TIM2
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM2EN;
+#endif
+    wcetReset();
+    __disable_irq();
+
+    for (int m = 0; m < (int)sizeof(modes); m++)
+    for (int state = STATE_SERVE; state <= STATE_WIN; state++)
+    for (int p = 0; p < 4; p++)
+    for (int pressed = 0; pressed < 2; pressed++)
+    {
+        led_mode = modes[m];
+        activeMode = &gameModes[modes[m]];
+        gameState = (PongState)state;
+        ledPattern = patterns[p];
+        currentServer = (uint8_t)(p & 1);
+
+        // One point from winning, so the miss states reach STATE_WIN
+        player1Score = (state == STATE_WIN) ? 3 : 2;
+        player2Score = 2;
+
+        for (int i = 0; i < NUM_BUTTONS; i++)
+            buttons[i].state = pressed ? 0 : 1;
+
+        SysTick_Handler();
+        PendSV_Handler();
+        SysTick->CTRL = 0;            // the handler may have restarted it
+
+#ifdef INPUT_TIM2
+        TIM2->EGR = TIM_EGR_UG;       // set UIF without the NVIC enabled
+        TIM2_IRQHandler();
+#endif
+    }
+#ifndef INPUT_TIM2
+    samplerWcetBench();
+#endif
+
+    SCB->ICSR = SCB_ICSR_PENDSVCLR_Msk;
+    __enable_irq();
+
+    // Back to power-on game state
+    led_mode = PLAY_MODE;
+    activeMode = &gameModes[PLAY_MODE];
+    gameState = STATE_SERVE;
+    ticklessDisarm();
+    coroInit(&winCo);
+    flashWinnerScore(0);
+    multiWinner = 0;
+    player1Score = 0;
+    player2Score = 0;
+    updatePlayerScore(0, 1);
+    updatePlayerScore(0, 2);
+    currentSpeed = INITIAL_SPEED;
+    currentServer = 1;
+    for (int i = 0; i < NUM_BUTTONS; i++) {
+        buttons[i].filter = 0xFF;
+        buttons[i].state = 1;
+    }
+
+    if (wcetCheckBudgets() != 0)
+    {
+        __BKPT(0);
+        while (1);
+    }
+
+    wcetReset();
+}
+#endif
@@ -0,0 +1,161 @@
+#include "analog.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: analog.c
+ * @brief: ADC + DMA analog paddle input
+ *
+ * TIM3 triggers ADC1 ANALOG_SAMPLE_RATE times a second. Each
+ * trigger converts IN5 then IN6, and DMA1 channel 1 moves both
+ * results into a circular buffer. The CPU only wakes at the
+ * half-transfer and transfer-complete interrupts. Each one averages
+ * the ANALOG_DECIMATE pairs in the finished half and runs a
+ * one-pole low-pass on the result.
+ *
+ * The filtered values are published with a sequence counter: odd
+ * while the DMA handler is writing, even when the values are
+ * stable. analogRead() retries until it sees the same even value
+ * before and after its copy. Readers must run at a lower priority
+ * than the DMA interrupt (PendSV or thread mode), which is true
+ * for the game.
+ *===============================================================*/
+
+#define ANALOG_BUF_LEN (2 * NUM_ANALOG_PADDLES * ANALOG_DECIMATE)
+#define ANALOG_TIMER_CLK   4000000  // TIM3 kernel clock (MSI)
+#define ADC_TRIG_TIM3_TRGO 4    // EXTSEL value for TIM3_TRGO
+#define ADC_SMP_47CYCLES   4    // 47.5 ADC clocks: enough for a 10k pot
+
+NOINIT static volatile uint16_t samples[ANALOG_BUF_LEN];   // DMA fills before first read
+static int32_t filterQ4[NUM_ANALOG_PADDLES];   // filter state, 4 fraction bits
+
+static volatile uint32_t sequence;
+static volatile uint16_t published[NUM_ANALOG_PADDLES];
+
+/****************************************************************************
+ * init_Analog()
+ * @parameter: None
+ * @return: None
+ * PA0/PA1 to analog, ADC1 powered up and calibrated, DMA1 channel 1 in
+ * circular mode, then TIM3 started as the conversion trigger.
+ ****************************************************************************/
+void init_Analog(void)
+{
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN | RCC_AHB2ENR_ADCEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM3EN;
+
+    // --- PA0, PA1: analog mode, connected to the ADC ---
+    GPIOA->MODER |= (3UL << (0 * 2)) | (3UL << (1 * 2));
+    GPIOA->PUPDR &= ~((3UL << (0 * 2)) | (3UL << (1 * 2)));
+    GPIOA->ASCR  |= GPIO_ASCR_ASC0 | GPIO_ASCR_ASC1;
+
+    // --- ADC1: HCLK/1, regulator on, calibrate, enable ---
+    ADC123_COMMON->CCR |= ADC_CCR_CKMODE_0;
+    ADC1->CR &= ~ADC_CR_DEEPPWD;
+    ADC1->CR |= ADC_CR_ADVREGEN;
+    for (volatile int d = 0; d < 100; d++);      // t_ADCVREG_STUP = 20 us
+
+    ADC1->CR &= ~ADC_CR_ADCALDIF;
+    ADC1->CR |= ADC_CR_ADCAL;
+    while (ADC1->CR & ADC_CR_ADCAL);
+
+    ADC1->ISR = ADC_ISR_ADRDY;
+    ADC1->CR |= ADC_CR_ADEN;
+    while (!(ADC1->ISR & ADC_ISR_ADRDY));
+
+    // Sequence: IN5 then IN6
+    ADC1->SQR1 = (1UL << ADC_SQR1_L_Pos) |
+                 (5UL << ADC_SQR1_SQ1_Pos) |
+                 (6UL << ADC_SQR1_SQ2_Pos);
+    ADC1->SMPR1 = (ADC_SMP_47CYCLES << ADC_SMPR1_SMP5_Pos) |
+                  (ADC_SMP_47CYCLES << ADC_SMPR1_SMP6_Pos);
+
+    // Hardware trigger on TIM3 TRGO, DMA circular, overwrite on overrun
+    ADC1->CFGR = ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | ADC_CFGR_OVRMOD |
+                 ADC_CFGR_EXTEN_0 | (ADC_TRIG_TIM3_TRGO << ADC_CFGR_EXTSEL_Pos);
+
+    // --- DMA1 channel 1 (request 0 = ADC1): ADC1->DR -> samples[] ---
+    DMA1_CSELR->CSELR &= ~DMA_CSELR_C1S;
+    DMA1_Channel1->CCR = 0;
+    DMA1_Channel1->CPAR = (uint32_t)&ADC1->DR;
+    DMA1_Channel1->CMAR = (uint32_t)samples;
+    DMA1_Channel1->CNDTR = ANALOG_BUF_LEN;
+    DMA1_Channel1->CCR = DMA_CCR_MINC | DMA_CCR_CIRC |
+                         DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 |
+                         DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+    ADC1->CR |= ADC_CR_ADSTART;                  // armed, waits for TIM3
+
+    // --- TIM3: update event on TRGO at ANALOG_SAMPLE_RATE ---
+    TIM3->PSC = 0;
+    TIM3->ARR = (ANALOG_TIMER_CLK / ANALOG_SAMPLE_RATE) - 1;
+    TIM3->CR2 = (TIM3->CR2 & ~(7UL << TIM_CR2_MMS_Pos)) | (2UL << TIM_CR2_MMS_Pos);
+    TIM3->CR1 |= TIM_CR1_CEN;
+}
+
+/****************************************************************************
+ * filterHalf()
+ * @parameter: half - first sample of the finished half-buffer
+ * @return: None
+ * Averages each channel over the half (decimation), then low-passes
+ * it with a 1/4 step and publishes the result.
+ ****************************************************************************/
+static RAMFUNC void filterHalf(const volatile uint16_t *half)
+{
+    uint32_t sum[NUM_ANALOG_PADDLES] = {0, 0};
+
+    for (int i = 0; i < ANALOG_DECIMATE; i++) {
+        sum[ANALOG_PADDLE_LEFT]  += half[2 * i];
+        sum[ANALOG_PADDLE_RIGHT] += half[2 * i + 1];
+    }
+
+    sequence++;                                   // odd: update in progress
+    for (int ch = 0; ch < NUM_ANALOG_PADDLES; ch++) {
+        int32_t meanQ4 = (int32_t)((sum[ch] << 4) / ANALOG_DECIMATE);
+        filterQ4[ch] += (meanQ4 - filterQ4[ch]) >> 2;
+        published[ch] = (uint16_t)(filterQ4[ch] >> 4);
+    }
+    sequence++;                                   // even: stable
+}
+
+/****************************************************************************
+ * DMA1_Channel1_IRQHandler()
+ * @parameter: None
+ * @return: None
+ * Half-transfer: the first half is complete. Transfer-complete: the
+ * second half is. The DMA keeps filling the other half meanwhile.
+ ****************************************************************************/
+RAMFUNC void DMA1_Channel1_IRQHandler(void)
+{
+    uint32_t isr = DMA1->ISR;
+
+    if (isr & DMA_ISR_HTIF1) {
+        DMA1->IFCR = DMA_IFCR_CHTIF1;
+        filterHalf(&samples[0]);
+    }
+    if (isr & DMA_ISR_TCIF1) {
+        DMA1->IFCR = DMA_IFCR_CTCIF1;
+        filterHalf(&samples[ANALOG_BUF_LEN / 2]);
+    }
+}
+
+/****************************************************************************
+ * analogRead()
+ * @parameter: snapshot - filled with the latest filtered values
+ * @return: None
+ ****************************************************************************/
+void analogRead(AnalogSnapshot *snapshot)
+{
+    uint32_t before, after;
+
+    do {
+        before = sequence;
+        for (int ch = 0; ch < NUM_ANALOG_PADDLES; ch++)
+            snapshot->paddle[ch] = published[ch];
+        after = sequence;
+    } while ((before & 1U) || before != after);
+
+    snapshot->sequence = after >> 1;
+}
@@ -0,0 +1,33 @@
+#ifndef ANALOG_H
+#define ANALOG_H
+
+/*************************************************
+ * @file: analog.h
+ *
+ * Header file for analog.c
+ * Analog paddles: two potentiometers / force sensors on PA0 and
+ * PA1, sampled continuously by ADC1 + DMA and filtered down to a
+ * snapshot the game can read at any time.
+ *************************************************/
+
+#include <stdint.h>
+
+#define ANALOG_PADDLE_LEFT   0   // PA0, ADC12_IN5
+#define ANALOG_PADDLE_RIGHT  1   // PA1, ADC12_IN6
+#define NUM_ANALOG_PADDLES   2
+
+#define ANALOG_SAMPLE_RATE   2000  // sample pairs per second (TIM3 trigger)
+#define ANALOG_DECIMATE      16    // pairs averaged per half-buffer
+#define ANALOG_MAX           4095  // 12-bit full scale
+
+typedef struct {
+    uint16_t paddle[NUM_ANALOG_PADDLES];  // filtered, 0..ANALOG_MAX
+    uint32_t sequence;                    // bumps on every update
+} AnalogSnapshot;
+
+void init_Analog(void);
+
+// Copies a consistent snapshot. Safe from any context; never blocks the writer.
+void analogRead(AnalogSnapshot *snapshot);
+
+#endif
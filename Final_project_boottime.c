@@ -0,0 +1,49 @@
+#include "boottime.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: boottime.c
+ * @brief: Reset-to-first-frame timeline
+ *
+ * Reset_Handler starts DWT->CYCCNT at 0 and marks the end of the
+ * RAM copy and the .bss clear. main() marks each init phase. Read
+ * bootTimeline[] (or bootMicros()) from the debugger after boot;
+ * BOOT_FIRST_FRAME is the number to keep small.
+ *
+ * main() splits init into a fast path (buttons, LEDs, saved game,
+ * first serve) and a deferred part for everything the first frame
+ * does not need. Large buffers that are always written before they
+ * are read are NOINIT, so the .bss clear does not spend time on them,
+ * and the stacks are painted for stack.c after the first frame.
+ *
+ * Renode has no DWT, so there the timeline stays 0. emu/pong.resc
+ * logs the time and instruction count at reset, main(), the first
+ * frame and schedInit() instead (the "T" lines of the trace).
+ *===============================================================*/
+
+NOINIT volatile uint32_t bootTimeline[NUM_BOOT_PHASES];
+
+/****************************************************************************
+ * bootTimerStart()
+ * @parameter: None
+ * @return: None
+ * Runs before .data/.bss are set up, so it only touches registers.
+ ****************************************************************************/
+void bootTimerStart(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/****************************************************************************
+ * bootMicros()
+ * @parameter: phase - BOOT_*
+ * @return: microseconds from reset to the end of that phase
+ ****************************************************************************/
+uint32_t bootMicros(uint8_t phase)
+{
+    if (phase >= NUM_BOOT_PHASES)
+        return 0;
+    return bootTimeline[phase] / (BOOT_HCLK / 1000000);
+}
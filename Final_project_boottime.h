@@ -0,0 +1,39 @@
+#ifndef BOOTTIME_H
+#define BOOTTIME_H
+
+/*************************************************
+ * @file: boottime.h
+ *
+ * Header file for boottime.c
+ * Boot timeline: the DWT cycle count (started at the top of
+ * Reset_Handler) at the end of each boot phase.
+ *************************************************/
+
+#include "stm32l476xx.h"
+
+// Phases, in boot order
+#define BOOT_COPY        0   // .data, RAMFUNC code and .sram2 copied
+#define BOOT_ZERO        1   // .bss zeroed
+#define BOOT_BUTTONS     2
+#define BOOT_LEDS        3
+#define BOOT_RESTORE     4   // saved game loaded (store, or Standby image)
+#define BOOT_FIRST_FRAME 5   // first serve shown on the LEDs
+#define BOOT_DEFERRED    6   // stack paint, matrix, brightness, capture, keypad, analog, sound
+#define BOOT_RUNNING     7   // tickless TIM5 and button input (TIM16 sampler, or TIM2) started
+#define NUM_BOOT_PHASES  8
+
+#define BOOT_HCLK        4000000   // core clock during boot (MSI)
+
+// Cycles since reset. Not zeroed at reset (it is written before .bss
+// is), so only phases reached on this boot are meaningful.
+extern volatile uint32_t bootTimeline[NUM_BOOT_PHASES];
+
+#define bootMark(phase) (bootTimeline[phase] = DWT->CYCCNT)
+
+// Starts the cycle counter from 0. First thing in Reset_Handler.
+void bootTimerStart(void);
+
+// Time from reset to the end of a phase, in microseconds
+uint32_t bootMicros(uint8_t phase);
+
+#endif
@@ -0,0 +1,282 @@
+#include "brightness.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: brightness.c
+ * @brief: LED brightness engine (bit-angle modulation + timer PWM)
+ *
+ * Every playfield and score LED gets a 4-bit level (0..BRIGHT_MAX).
+ *
+ * PB8/PB9 (player 1 score) are TIM4_CH3/CH4, so they use hardware
+ * PWM and cost nothing once CCR is written.
+ *
+ * The other pins (PC5-PC12, PC2, PC3, PH0, PH1) have no timer
+ * channel, so they use bit-angle modulation on TIM7. A frame is
+ * split into BRIGHT_BITS planes, and plane k lasts BAM_BASE_US << k.
+ * At the start of plane k one BSRR write per port turns on every LED
+ * whose level has bit k set and turns off the rest. Each level is
+ * then shown for level * BAM_BASE_US out of each frame.
+ *
+ * CPU load: BRIGHT_BITS interrupts per frame (4, not 15 as with
+ * counter-based PWM). With BAM_BASE_US = 400 a frame is 6 ms
+ * (~167 Hz, no visible flicker), so 667 interrupts/s. Three of them
+ * only write two BSRRs and ARR (~30 cycles). The fourth also steps
+ * the effects and, only if a level changed, rebuilds the masks:
+ * bounded by NUM_BRIGHT_LEDS * BRIGHT_BITS, roughly 800 cycles.
+ * Worst case (a change every frame) is ~3% of the 4 MHz core. In
+ * play levels only move on effect frames and ball steps, so ~1%.
+ *
+ * Effects are stepped every BRIGHT_FX_FRAMES frames (24 ms):
+ *   trail - a playfield LED the ball just left fades out over
+ *           15 steps (~360 ms) instead of going dark
+ *   pulse - the LED ramps between 1 and its peak and back
+ *           (~0.7 s per cycle), used for the winner's score
+ *===============================================================*/
+
+#define BAM_TIMER_CLK   4000000  // TIM7/TIM4 kernel clock (MSI)
+#define BAM_TICK_HZ     1000000  // 1 us timer ticks
+#define BAM_BASE_US     400      // length of plane 0
+#define BRIGHT_FX_FRAMES 4       // frames between effect steps
+#define PWM_STEP        64       // TIM4 counts per level (1.04 kHz PWM)
+
+typedef struct {
+    GPIO_TypeDef *port;         // BAM pin, or NULL for a TIM4 channel
+    uint8_t pin;
+    volatile uint32_t *ccr;     // TIM4 compare register, or NULL for BAM
+} BrightPin;
+
+static const BrightPin pins[NUM_BRIGHT_LEDS] = {
+    {GPIOC, 5, 0}, {GPIOC, 6, 0}, {GPIOC, 7, 0}, {GPIOC, 8, 0},
+    {GPIOC, 9, 0}, {GPIOC, 10, 0}, {GPIOC, 11, 0}, {GPIOC, 12, 0},
+    {0, 8, &TIM4->CCR3}, {0, 9, &TIM4->CCR4}, {GPIOH, 0, 0},   // player 1
+    {GPIOH, 1, 0}, {GPIOC, 2, 0}, {GPIOC, 3, 0}                // player 2
+};
+
+typedef struct {
+    uint8_t level;      // level being displayed
+    uint8_t peak;       // level when on
+    uint8_t on;
+    uint8_t effect;     // BRIGHT_STEADY / TRAIL / PULSE
+    int8_t  dir;        // pulse direction
+} BrightChannel;
+
+static volatile BrightChannel chan[NUM_BRIGHT_LEDS];
+
+// BSRR words for each bit-plane: set bits low, reset bits high
+static uint32_t planeC[BRIGHT_BITS];
+static uint32_t planeH[BRIGHT_BITS];
+static uint8_t plane;
+static uint8_t fxCount;
+
+volatile uint8_t brightnessActive = 0;
+
+static void frameUpdate(void);
+static void buildPlanes(void);
+
+/****************************************************************************
+ * init_Brightness()
+ * @parameter: None
+ * @return: None
+ * Call after init_LEDs_PC5to12() and configureInterruptPriorities().
+ * Moves PB8/PB9 to TIM4 PWM and starts the TIM7 bit-plane interrupt.
+ * From here on the LED functions in led_setup.c drive the levels
+ * instead of ODR.
+ ****************************************************************************/
+void init_Brightness(void)
+{
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM4EN | RCC_APB1ENR1_TIM7EN;
+
+    for (int i = 0; i < NUM_BRIGHT_LEDS; i++) {
+        chan[i].level = 0;
+        chan[i].peak = BRIGHT_MAX;
+        chan[i].on = 0;
+        chan[i].effect = (i < BRIGHT_P1_SCORE) ? BRIGHT_TRAIL : BRIGHT_STEADY;
+        chan[i].dir = 1;
+    }
+    buildPlanes();                    // all off
+
+    // --- PB8, PB9: alternate function 2 (TIM4_CH3, TIM4_CH4) ---
+    GPIOB->AFR[1] = (GPIOB->AFR[1] & ~((0xFUL << 0) | (0xFUL << 4))) |
+                    (2UL << 0) | (2UL << 4);
+    GPIOB->MODER = (GPIOB->MODER & ~((3UL << (8 * 2)) | (3UL << (9 * 2)))) |
+                   (2UL << (8 * 2)) | (2UL << (9 * 2));
+
+    // --- TIM4: 1 MHz count, PWM mode 1 on CH3/CH4, preloaded CCR ---
+    TIM4->PSC = (BAM_TIMER_CLK / BAM_TICK_HZ) - 1;
+    TIM4->ARR = (BRIGHT_MAX * PWM_STEP) - 1;
+    TIM4->CCR3 = 0;
+    TIM4->CCR4 = 0;
+    TIM4->CCMR2 = TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1 | TIM_CCMR2_OC3PE |
+                  TIM_CCMR2_OC4M_2 | TIM_CCMR2_OC4M_1 | TIM_CCMR2_OC4PE;
+    TIM4->CCER |= TIM_CCER_CC3E | TIM_CCER_CC4E;
+    TIM4->CR1 |= TIM_CR1_ARPE | TIM_CR1_CEN;
+
+    // --- TIM7: bit-plane timer, ARR rewritten for every plane ---
+    plane = 0;
+    fxCount = 0;
+    TIM7->PSC = (BAM_TIMER_CLK / BAM_TICK_HZ) - 1;
+    TIM7->ARR = BAM_BASE_US - 1;
+    TIM7->EGR = TIM_EGR_UG;           // load PSC
+    TIM7->SR &= ~TIM_SR_UIF;
+    TIM7->DIER |= TIM_DIER_UIE;
+
+    brightnessActive = 1;
+    NVIC_EnableIRQ(TIM7_IRQn);
+    TIM7->CR1 |= TIM_CR1_CEN;
+}
+
+/****************************************************************************
+ * TIM7_IRQHandler()
+ * @parameter: None
+ * @return: None
+ * Start of a bit-plane: output its masks, and time it by setting ARR
+ * (no preload, so the new ARR applies to the period just started).
+ * After the last plane is started, prepare the next frame.
+ ****************************************************************************/
+RAMFUNC void TIM7_IRQHandler(void)
+{
+    TIM7->SR &= ~TIM_SR_UIF;
+
+    GPIOC->BSRR = planeC[plane];
+    GPIOH->BSRR = planeH[plane];
+    TIM7->ARR = (BAM_BASE_US << plane) - 1;
+
+    if (++plane == BRIGHT_BITS) {
+        plane = 0;
+        frameUpdate();       // runs during the longest plane
+    }
+}
+
+/****************************************************************************
+ * stepEffect()
+ * @parameter: c - channel to advance
+ * @return: None
+ * Called once per channel every BRIGHT_FX_FRAMES frames.
+ ****************************************************************************/
+static RAMFUNC void stepEffect(volatile BrightChannel *c)
+{
+    if (c->effect == BRIGHT_TRAIL && !c->on && c->level > 0) {
+        c->level--;
+    }
+    else if (c->effect == BRIGHT_PULSE && c->on) {
+        if (c->level >= c->peak) c->dir = -1;
+        else if (c->level <= 1)  c->dir = 1;
+        c->level += c->dir;
+    }
+}
+
+/****************************************************************************
+ * frameUpdate()
+ * @parameter: None
+ * @return: None
+ * Applies on/off changes at once, steps effects on their frames,
+ * then rebuilds the planes if any level moved.
+ ****************************************************************************/
+static RAMFUNC void frameUpdate(void)
+{
+    uint8_t changed = 0;
+    uint8_t fxFrame = 0;
+
+    if (++fxCount >= BRIGHT_FX_FRAMES) {
+        fxCount = 0;
+        fxFrame = 1;
+    }
+
+    for (int i = 0; i < NUM_BRIGHT_LEDS; i++) {
+        volatile BrightChannel *c = &chan[i];
+        uint8_t old = c->level;
+
+        if (c->on && c->effect != BRIGHT_PULSE)
+            c->level = c->peak;
+        else if (!c->on && c->effect != BRIGHT_TRAIL)
+            c->level = 0;
+        else if (fxFrame)
+            stepEffect(c);
+
+        if (c->level != old)
+            changed = 1;
+    }
+    if (changed)
+        buildPlanes();
+}
+
+/****************************************************************************
+ * buildPlanes()
+ * @parameter: None
+ * @return: None
+ * Turns the channel levels into per-plane BSRR words and TIM4 compares.
+ ****************************************************************************/
+static RAMFUNC void buildPlanes(void)
+{
+    for (int p = 0; p < BRIGHT_BITS; p++) {
+        uint32_t setC = 0, setH = 0, allC = 0, allH = 0;
+
+        for (int i = 0; i < NUM_BRIGHT_LEDS; i++) {
+            uint32_t bit = 1UL << pins[i].pin;
+            uint32_t lit = (chan[i].level >> p) & 1U;
+
+            if (pins[i].port == GPIOC) {
+                allC |= bit;
+                if (lit) setC |= bit;
+            }
+            else if (pins[i].port == GPIOH) {
+                allH |= bit;
+                if (lit) setH |= bit;
+            }
+        }
+        planeC[p] = setC | ((allC & ~setC) << 16);
+        planeH[p] = setH | ((allH & ~setH) << 16);
+    }
+
+    for (int i = 0; i < NUM_BRIGHT_LEDS; i++)
+        if (pins[i].ccr)
+            *pins[i].ccr = chan[i].level * PWM_STEP;
+}
+
+/****************************************************************************
+ * brightnessSetOn()
+ * @parameter: led - BRIGHT_* channel, on - 1 to light it
+ * @return: None
+ * Takes effect at the next frame (within 6 ms).
+ ****************************************************************************/
+RAMFUNC void brightnessSetOn(uint8_t led, uint8_t on)
+{
+    if (led < NUM_BRIGHT_LEDS)
+        chan[led].on = on ? 1 : 0;
+}
+
+/****************************************************************************
+ * brightnessGetOn()
+ * @parameter: led - BRIGHT_* channel
+ * @return: 1 if the channel is on
+ ****************************************************************************/
+uint8_t brightnessGetOn(uint8_t led)
+{
+    return (led < NUM_BRIGHT_LEDS) ? chan[led].on : 0;
+}
+
+/****************************************************************************
+ * brightnessSetEffect()
+ * @parameter: led - BRIGHT_* channel, effect - BRIGHT_STEADY/TRAIL/PULSE
+ * @return: None
+ ****************************************************************************/
+void brightnessSetEffect(uint8_t led, uint8_t effect)
+{
+    if (led < NUM_BRIGHT_LEDS) {
+        chan[led].dir = 1;
+        chan[led].effect = effect;
+    }
+}
+
+/****************************************************************************
+ * brightnessSetLevel()
+ * @parameter: led - BRIGHT_* channel, level - 0..BRIGHT_MAX
+ * @return: None
+ * Sets the level the channel shows when on (the top of a pulse).
+ ****************************************************************************/
+void brightnessSetLevel(uint8_t led, uint8_t level)
+{
+    if (led < NUM_BRIGHT_LEDS)
+        chan[led].peak = (level > BRIGHT_MAX) ? BRIGHT_MAX : level;
+}
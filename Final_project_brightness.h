@@ -0,0 +1,37 @@
+#ifndef BRIGHTNESS_H
+#define BRIGHTNESS_H
+
+/*************************************************
+ * @file: brightness.h
+ *
+ * Header file for brightness.c
+ * 4-bit brightness for the playfield and score LEDs, with trail
+ * and pulse effects.
+ *************************************************/
+
+#include <stdint.h>
+
+// LED channels
+#define BRIGHT_PLAYFIELD   0   // 0..7  = PC5..PC12 (ledPattern bit 0..7)
+#define BRIGHT_P1_SCORE    8   // 8..10 = PB8, PB9, PH0
+#define BRIGHT_P2_SCORE    11  // 11..13 = PH1, PC2, PC3
+#define NUM_BRIGHT_LEDS    14
+
+#define BRIGHT_BITS   4
+#define BRIGHT_MAX    ((1 << BRIGHT_BITS) - 1)
+
+// What a channel does while on/off
+#define BRIGHT_STEADY 0   // full when on, dark when off
+#define BRIGHT_TRAIL  1   // full when on, fades out after it turns off
+#define BRIGHT_PULSE  2   // breathes while on, dark when off
+
+extern volatile uint8_t brightnessActive;
+
+void init_Brightness(void);
+
+void brightnessSetOn(uint8_t led, uint8_t on);
+uint8_t brightnessGetOn(uint8_t led);
+void brightnessSetEffect(uint8_t led, uint8_t effect);
+void brightnessSetLevel(uint8_t led, uint8_t level);
+
+#endif
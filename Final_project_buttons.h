@@ -9,12 +9,14 @@
 #define BTN_LEFT    1
 #define BTN_USER    2
 
-// structure which stores all the buttons
+// All three buttons are on port C
+#define BUTTON_PORT GPIOC
+
+// structure which stores all the buttons (3 bytes each)
 typedef struct {
-    uint32_t filter;
-    uint32_t state;
-    GPIO_TypeDef *port;
-    uint32_t pin;
+    uint8_t filter;   // INPUT_TIM2 shift-register debounce
+    uint8_t state;    // 0 = pressed, 1 = released
+    uint8_t pin;      // pin number on BUTTON_PORT
 } Button;
 
 // Allows global access to the array
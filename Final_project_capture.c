@@ -0,0 +1,160 @@
+#include "capture.h"
+#include "irq.h"
+#include "wcet.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: capture.c
+ * @brief: Timestamped button input
+ *
+ * None of the button pins (PC0, PC1, PC13) has a timer input
+ * capture function, so EXTI does the capturing. Each EXTI handler
+ * reads TIM5->CNT as its first instruction. Entry latency on the
+ * M4 is a fixed 12 cycles, so the timestamp is exact to a few
+ * counts. Edges go into a per-button lock-free FIFO (the handler
+ * writes head, the reader writes tail).
+ *
+ * The handler also keeps pressTime/releaseTime: the first edge of
+ * a transition after CAPTURE_SETTLE counts of quiet. That is the
+ * real moment the player acted, with the bounce removed, and it
+ * is what reaction-time statistics should use.
+ *===============================================================*/
+
+CaptureChannel capture[NUM_BUTTONS];
+
+/****************************************************************************
+ * init_Capture()
+ * @parameter: None
+ * @return: None
+ * Starts TIM5 as a free-running 32-bit counter and routes PC0, PC1 and
+ * PC13 to EXTI lines 0, 1 and 13 on both edges.
+ ****************************************************************************/
+void init_Capture(void)
+{
+    // --- TIM5: free-running time base, no prescaler ---
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM5EN;
+    TIM5->PSC = 0;
+    TIM5->ARR = 0xFFFFFFFF;
+    TIM5->EGR = TIM_EGR_UG;
+    TIM5->CR1 |= TIM_CR1_CEN;
+
+    // --- EXTI lines 0, 1, 13 from port C ---
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    SYSCFG->EXTICR[0] = (SYSCFG->EXTICR[0] & ~(SYSCFG_EXTICR1_EXTI0 | SYSCFG_EXTICR1_EXTI1))
+                      | SYSCFG_EXTICR1_EXTI0_PC | SYSCFG_EXTICR1_EXTI1_PC;
+    SYSCFG->EXTICR[3] = (SYSCFG->EXTICR[3] & ~SYSCFG_EXTICR4_EXTI13)
+                      | SYSCFG_EXTICR4_EXTI13_PC;
+
+    EXTI->RTSR1 |= (1U << 0) | (1U << 1) | (1U << 13);
+    EXTI->FTSR1 |= (1U << 0) | (1U << 1) | (1U << 13);
+    EXTI->PR1    = (1U << 0) | (1U << 1) | (1U << 13);
+    EXTI->IMR1  |= (1U << 0) | (1U << 1) | (1U << 13);
+
+    NVIC_EnableIRQ(EXTI0_IRQn);
+    NVIC_EnableIRQ(EXTI1_IRQn);
+    NVIC_EnableIRQ(EXTI15_10_IRQn);
+}
+
+/****************************************************************************
+ * captureEdge()
+ * @parameter: button - BTN_* index, time - TIM5 count at handler entry
+ * @return: None
+ * Queues one edge and updates the bounce-free press/release times.
+ ****************************************************************************/
+static RAMFUNC void captureEdge(uint8_t button, uint32_t time)
+{
+    CaptureChannel *c = &capture[button];
+    uint8_t level = (BUTTON_PORT->IDR >> buttons[button].pin) & 1U;
+    uint8_t head = c->head;
+
+    if ((uint8_t)(head - c->tail) < CAPTURE_FIFO_SIZE) {
+        c->fifo[head & (CAPTURE_FIFO_SIZE - 1)].time = time;
+        c->fifo[head & (CAPTURE_FIFO_SIZE - 1)].level = level;
+        c->head = head + 1;
+    } else {
+        c->overflows++;
+    }
+
+    if (time - c->lastEdge > CAPTURE_SETTLE) {
+        if (level == 0)
+            c->pressTime = time;
+        else
+            c->releaseTime = time;
+    }
+    c->lastEdge = time;
+}
+
+/****************************************************************************
+ * EXTI0_IRQHandler(), EXTI1_IRQHandler(), EXTI15_10_IRQHandler()
+ * @parameter: None
+ * @return: None
+ * Latch TIM5 first, then clear the pending line and queue the edge.
+ ****************************************************************************/
+RAMFUNC void EXTI0_IRQHandler(void)
+{
+    uint32_t time = TIM5->CNT;
+    uint32_t start = WCET_START();
+
+    EXTI->PR1 = (1U << 0);
+    captureEdge(BTN_RIGHT, time);
+    wcetStop(WCET_EXTI0, start);
+}
+
+RAMFUNC void EXTI1_IRQHandler(void)
+{
+    uint32_t time = TIM5->CNT;
+    uint32_t start = WCET_START();
+
+    EXTI->PR1 = (1U << 1);
+    captureEdge(BTN_LEFT, time);
+    wcetStop(WCET_EXTI1, start);
+}
+
+RAMFUNC void EXTI15_10_IRQHandler(void)
+{
+    uint32_t time = TIM5->CNT;
+    uint32_t start = WCET_START();
+
+    if (EXTI->PR1 & (1U << 13)) {
+        EXTI->PR1 = (1U << 13);
+        captureEdge(BTN_USER, time);
+    }
+    wcetStop(WCET_EXTI15_10, start);
+}
+
+/****************************************************************************
+ * captureNow()
+ * @return: current TIM5 count, in the same units as the capture times
+ ****************************************************************************/
+RAMFUNC uint32_t captureNow(void)
+{
+    return TIM5->CNT;
+}
+
+/****************************************************************************
+ * captureRead()
+ * @parameter: button - BTN_* index, event - filled with the oldest edge
+ * @return: 1 if an edge was read, 0 if the FIFO was empty
+ ****************************************************************************/
+int captureRead(uint8_t button, CaptureEvent *event)
+{
+    CaptureChannel *c = &capture[button];
+    uint8_t tail = c->tail;
+
+    if (tail == c->head)
+        return 0;
+
+    *event = c->fifo[tail & (CAPTURE_FIFO_SIZE - 1)];
+    c->tail = tail + 1;
+    return 1;
+}
+
+/****************************************************************************
+ * captureLastPress()
+ * @parameter: button - BTN_* index
+ * @return: TIM5 time of the first edge of the latest press
+ ****************************************************************************/
+RAMFUNC uint32_t captureLastPress(uint8_t button)
+{
+    return capture[button].pressTime;
+}
@@ -0,0 +1,49 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+/*************************************************
+ * @file: capture.h
+ *
+ * Header file for capture.c
+ * Timestamped button edges. Every edge on PC0, PC1 and PC13 is
+ * latched against the free-running TIM5 counter (one count per
+ * core clock, 250 ns at 4 MHz) and queued per button.
+ *************************************************/
+
+#include <stdint.h>
+#include "buttons.h"
+
+#define CAPTURE_FIFO_SIZE 16            // power of two
+#define CAPTURE_SETTLE    80000         // 20 ms without edges = new press/release
+
+// One raw edge: when it happened and the pin level after it (0 = pressed)
+typedef struct {
+    uint32_t time;
+    uint8_t level;
+} CaptureEvent;
+
+typedef struct {
+    CaptureEvent fifo[CAPTURE_FIFO_SIZE];
+    volatile uint8_t head;      // written by the EXTI handler
+    volatile uint8_t tail;      // written by the reader
+    volatile uint32_t overflows;
+    volatile uint32_t lastEdge;
+    volatile uint32_t pressTime;   // first edge of the latest press (bounce removed)
+    volatile uint32_t releaseTime; // first edge of the latest release
+} CaptureChannel;
+
+// Indexed by BTN_RIGHT, BTN_LEFT, BTN_USER
+extern CaptureChannel capture[NUM_BUTTONS];
+
+void init_Capture(void);
+
+// Current timestamp in capture units
+uint32_t captureNow(void);
+
+// Pops the oldest edge for a button. Returns 0 if there is none.
+int captureRead(uint8_t button, CaptureEvent *event);
+
+// Timestamp of the start of the latest press of a button
+uint32_t captureLastPress(uint8_t button);
+
+#endif
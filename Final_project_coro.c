@@ -0,0 +1,56 @@
+#include "coro.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: coro.c
+ * @brief: Event posting for the stackless coroutines in coro.h
+ *
+ * The waits themselves are macros. Only the event mask is shared
+ * with interrupts, so posting and taking are done with PRIMASK set:
+ * an ISR posting between the read and the clear is never lost.
+ *===============================================================*/
+
+/****************************************************************************
+ * coroInit()
+ * @parameter: co - coroutine state
+ * @return: None
+ ****************************************************************************/
+void coroInit(Coro *co)
+{
+    co->line = 0;
+    co->wait = 0;
+    co->events = 0;
+    co->got = 0;
+}
+
+/****************************************************************************
+ * coroPost()
+ * @parameter: co - coroutine, events - bits to post
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void coroPost(Coro *co, uint8_t events)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    co->events |= events;
+    __set_PRIMASK(primask);
+}
+
+/****************************************************************************
+ * coroTake()
+ * @parameter: co - coroutine, mask - events to take
+ * @return: the events in mask that were pending
+ ****************************************************************************/
+RAMFUNC uint8_t coroTake(Coro *co, uint8_t mask)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t got;
+
+    __disable_irq();
+    got = co->events & mask;
+    co->events &= (uint8_t)~mask;
+    __set_PRIMASK(primask);
+
+    return got;
+}
@@ -0,0 +1,81 @@
+#ifndef CORO_H
+#define CORO_H
+
+/*************************************************
+ * @file: coro.h
+ *
+ * Header file for coro.c
+ * Stackless coroutines (protothread style) for flows that take
+ * many ticks, written as straight-line code.
+ *
+ * A coroutine is a function returning CORO_RUNNING or CORO_DONE.
+ * Each call is one tick: it resumes at the wait it stopped in and
+ * runs to the next one. Its whole state is a 6-byte Coro, so:
+ *   - locals do not survive a wait (keep them static)
+ *   - a wait cannot sit inside a switch in the coroutine body
+ * After CORO_DONE the next call starts from the top again.
+ *
+ *   static uint8_t flow(Coro *co)
+ *   {
+ *       CORO_BEGIN(co);
+ *       ...
+ *       CORO_AWAIT_TICKS(co, 5);
+ *       CORO_AWAIT_ANY(co, EV_PRESS, 20);
+ *       if (co->got) ...               // 0 = timed out
+ *       CORO_END(co);
+ *   }
+ *************************************************/
+
+#include <stdint.h>
+
+#define CORO_RUNNING 0
+#define CORO_DONE    1
+
+typedef struct {
+    uint16_t line;              // resume point (0 = start)
+    uint16_t wait;              // ticks left in the current wait
+    volatile uint8_t events;    // posted and not yet taken
+    uint8_t got;                // events that ended the last wait, 0 = timeout
+} Coro;
+
+// Back to the top, with no events pending
+void coroInit(Coro *co);
+
+// Post events (bit mask) to a coroutine; safe from any interrupt
+void coroPost(Coro *co, uint8_t events);
+
+// Takes (clears) and returns the posted events in mask
+uint8_t coroTake(Coro *co, uint8_t mask);
+
+#define CORO_BEGIN(co)  switch ((co)->line) { case 0:
+
+#define CORO_END(co)    } (co)->line = 0; return CORO_DONE
+
+// Resume point: the next call continues from here
+#define CORO_MARK(co)   (co)->line = __LINE__; case __LINE__:
+
+#define CORO_YIELD(co) \
+    do { (co)->line = __LINE__; return CORO_RUNNING; case __LINE__:; } while (0)
+
+// Wait until cond is true (checked once per tick, first check now)
+#define CORO_AWAIT_UNTIL(co, cond) \
+    do { CORO_MARK(co) if (!(cond)) return CORO_RUNNING; } while (0)
+
+// Wait n ticks
+#define CORO_AWAIT_TICKS(co, n) \
+    do { (co)->wait = (n); CORO_MARK(co) \
+         if ((co)->wait) { (co)->wait--; return CORO_RUNNING; } } while (0)
+
+// Wait for any event in mask; co->got holds the ones taken
+#define CORO_AWAIT_EVENT(co, mask) \
+    do { CORO_MARK(co) if (!((co)->events & (mask))) return CORO_RUNNING; \
+         (co)->got = coroTake((co), (mask)); } while (0)
+
+// Wait for any event in mask, at most n ticks (co->got == 0: timed out)
+#define CORO_AWAIT_ANY(co, mask, n) \
+    do { (co)->wait = (n); CORO_MARK(co) \
+         if ((co)->events & (mask)) { (co)->got = coroTake((co), (mask)); } \
+         else if ((co)->wait) { (co)->wait--; return CORO_RUNNING; } \
+         else { (co)->got = 0; } } while (0)
+
+#endif
@@ -0,0 +1,207 @@
+#include "debounce.h"
+
+/*=================================================================
+ * @file: debounce.c
+ * @brief: Debounce strategies for the Pong buttons
+ *
+ * All strategies start in the released state (1) and are fed one
+ * raw sample per debounce tick. They are kept free of register
+ * access so the same code can be driven by TIM2, by the DMA sampler
+ * (sampler.c), by the bench in debounce_bench.c or on the host
+ * (tools/debounce_host.c).
+ *===============================================================*/
+
+/****************************************************************************
+ * debounceShift()
+ * @parameter: d - debouncer state, sample - raw pin level
+ * @return: debounced state
+ * Same filter as TIM2_IRQHandler: the state only changes once the
+ * last 8 samples all agree.
+ ****************************************************************************/
+void debounceShiftInit(ShiftDebouncer *d)
+{
+    d->filter = DEBOUNCE_SHIFT_MASK;
+    d->state = 1;
+}
+
+uint8_t debounceShift(ShiftDebouncer *d, uint8_t sample)
+{
+    d->filter = (uint8_t)((d->filter << 1) | (sample & 1U));
+
+    if (d->filter == 0x00)
+        d->state = 0;
+    else if (d->filter == DEBOUNCE_SHIFT_MASK)
+        d->state = 1;
+
+    return d->state;
+}
+
+/****************************************************************************
+ * debounceIntegrator()
+ * @parameter: d - debouncer state, sample - raw pin level
+ * @return: debounced state
+ * Counts up on released samples and down on pressed samples.
+ * Single-sample glitches only move the count by one, so noise
+ * slows detection down instead of restarting it.
+ ****************************************************************************/
+void debounceIntegratorInit(IntegratorDebouncer *d)
+{
+    d->count = DEBOUNCE_INTEGRATOR_MAX;
+    d->state = 1;
+}
+
+uint8_t debounceIntegrator(IntegratorDebouncer *d, uint8_t sample)
+{
+    if (sample) {
+        if (d->count < DEBOUNCE_INTEGRATOR_MAX) d->count++;
+    } else {
+        if (d->count > 0) d->count--;
+    }
+
+    if (d->count == 0)
+        d->state = 0;
+    else if (d->count == DEBOUNCE_INTEGRATOR_MAX)
+        d->state = 1;
+
+    return d->state;
+}
+
+/****************************************************************************
+ * debounceLockout()
+ * @parameter: d - debouncer state, sample - raw pin level
+ * @return: debounced state
+ * Reports the first edge immediately, then ignores the pin until
+ * the bounce is over. Zero latency, but any spike becomes an edge.
+ ****************************************************************************/
+void debounceLockoutInit(LockoutDebouncer *d)
+{
+    d->lockout = 0;
+    d->state = 1;
+}
+
+uint8_t debounceLockout(LockoutDebouncer *d, uint8_t sample)
+{
+    if (d->lockout) {
+        d->lockout--;
+    } else if ((sample & 1U) != d->state) {
+        d->state = sample & 1U;
+        d->lockout = DEBOUNCE_LOCKOUT_SAMPLES;
+    }
+    return d->state;
+}
+
+/****************************************************************************
+ * debounceVertical()
+ * @parameter: d - debouncer state, samples - one raw pin per bit
+ * @return: debounced state of all 32 lanes
+ * Each bit lane has its own 2-bit counter spread over cnt0/cnt1.
+ * A lane toggles after 4 samples that differ from its state, and
+ * all lanes are updated with a handful of logic ops.
+ ****************************************************************************/
+void debounceVerticalInit(VerticalDebouncer *d)
+{
+    d->cnt0 = 0;
+    d->cnt1 = 0;
+    d->state = 0xFFFFFFFFUL;
+}
+
+uint32_t debounceVertical(VerticalDebouncer *d, uint32_t samples)
+{
+    uint32_t delta = samples ^ d->state;   // lanes that disagree with state
+
+    d->cnt1 = (d->cnt1 ^ d->cnt0) & delta; // count down, reset where equal
+    d->cnt0 = ~d->cnt0 & delta;
+
+    d->state ^= delta & ~(d->cnt0 | d->cnt1); // toggle lanes that hit 0
+    return d->state;
+}
+
+/****************************************************************************
+ * debounceBatch()
+ * @parameter: d - debouncer state, samples/count - raw port samples,
+ *             oldest first, edges/maxEdges - where to put the edges
+ * @return: number of edges written to edges[]
+ * A lane takes a new level once it has gone DEBOUNCE_BATCH_STABLE
+ * samples without a raw edge. The edge is dated to the first raw
+ * edge after the lane was last quiet, so bounce delays the report
+ * but not the timestamp. A burst that settles back on the old level
+ * is no edge at all.
+ *
+ * Most buffers hold no activity at all. That is checked first with
+ * one AND and one OR per sample; only a buffer with a raw edge in it,
+ * or a lane still settling, goes through the per-sample loop.
+ ****************************************************************************/
+void debounceBatchInit(BatchDebouncer *d, uint16_t mask)
+{
+    d->mask = mask;
+    d->state = mask;                       // released (pull-ups)
+    d->target = mask;
+    d->settling = 0;
+    d->sample = 0;
+    d->lost = 0;
+    for (int i = 0; i < DEBOUNCE_BATCH_LANES; i++) {
+        d->run[i] = DEBOUNCE_BATCH_STABLE;
+        d->edgeAt[i] = 0;
+    }
+}
+
+uint8_t debounceBatch(BatchDebouncer *d, const volatile uint16_t *samples,
+                      uint16_t count, BatchEdge *edges, uint8_t maxEdges)
+{
+    uint16_t lanes;
+    uint8_t n = 0;
+
+    if (!d->settling) {
+        uint16_t all = 0xFFFF, any = 0;
+
+        for (uint16_t i = 0; i < count; i++) {
+            all &= samples[i];
+            any |= samples[i];
+        }
+        // Every masked lane stayed at its debounced level
+        if ((((all ^ d->state) | (any ^ d->state)) & d->mask) == 0) {
+            d->sample += count;
+            return 0;
+        }
+    }
+
+    for (uint16_t i = 0; i < count; i++, d->sample++) {
+        uint16_t raw = (uint16_t)((samples[i] ^ d->target) & d->mask);
+
+        // Raw edges restart the quiet count of their lane
+        if (raw) {
+            d->target ^= raw;
+            d->settling |= raw;
+            for (lanes = raw; lanes; lanes &= (uint16_t)(lanes - 1)) {
+                int lane = __builtin_ctz(lanes);
+                if (d->run[lane] >= DEBOUNCE_BATCH_STABLE)
+                    d->edgeAt[lane] = d->sample;
+                d->run[lane] = 0;
+            }
+        }
+
+        for (lanes = d->settling; lanes; lanes &= (uint16_t)(lanes - 1)) {
+            int lane = __builtin_ctz(lanes);
+            uint16_t bit = (uint16_t)(1U << lane);
+
+            if (++d->run[lane] < DEBOUNCE_BATCH_STABLE)
+                continue;
+
+            d->settling &= (uint16_t)~bit;
+            if (!((d->target ^ d->state) & bit))
+                continue;                  // settled back where it was
+
+            d->state ^= bit;
+            if (n < maxEdges) {
+                edges[n].sample = d->edgeAt[lane];
+                edges[n].lane = (uint8_t)lane;
+                edges[n].level = (d->target & bit) != 0;
+                n++;
+            }
+            else {
+                d->lost++;
+            }
+        }
+    }
+    return n;
+}
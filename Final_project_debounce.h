@@ -0,0 +1,83 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+/*************************************************
+ * @file: debounce.h
+ *
+ * Header file for debounce.c
+ * Interchangeable debounce strategies. Each one takes a raw
+ * sample (1 = released, 0 = pressed, like the IDR bit) and
+ * returns the debounced state. debounceBatch() instead takes a
+ * whole buffer of port samples (sampler.c) and returns the edges.
+ *************************************************/
+
+#include <stdint.h>
+
+// TIM2 filter (INPUT_TIM2 builds): 8 equal samples in a shift register
+#define DEBOUNCE_SHIFT_MASK      0xFF
+// Integrator saturates after this many net samples in one direction
+#define DEBOUNCE_INTEGRATOR_MAX  4
+// Edge+lockout ignores the pin for this many samples after an edge
+#define DEBOUNCE_LOCKOUT_SAMPLES 8
+// Batch: equal samples in a row that confirm a new level
+#define DEBOUNCE_BATCH_STABLE    20
+#define DEBOUNCE_BATCH_LANES     16   // one per bit of a 16-bit port sample
+
+typedef struct {
+    uint8_t filter;
+    uint8_t state;
+} ShiftDebouncer;
+
+typedef struct {
+    uint8_t count;
+    uint8_t state;
+} IntegratorDebouncer;
+
+typedef struct {
+    uint8_t lockout;
+    uint8_t state;
+} LockoutDebouncer;
+
+// Vertical counter: 32 independent 2-bit counters, one per bit lane
+typedef struct {
+    uint32_t cnt0;
+    uint32_t cnt1;
+    uint32_t state;
+} VerticalDebouncer;
+
+// Batch debouncer over the masked bits of a stream of port samples
+typedef struct {
+    uint16_t mask;       // lanes debounced
+    uint16_t state;      // debounced levels
+    uint16_t target;     // level each lane has had since its last raw edge
+    uint16_t settling;   // lanes with a raw edge in the last STABLE samples
+    uint32_t sample;     // samples consumed so far
+    uint32_t lost;       // edges that did not fit in the caller's array
+    uint8_t run[DEBOUNCE_BATCH_LANES];      // samples since the last raw edge
+    uint32_t edgeAt[DEBOUNCE_BATCH_LANES];  // first raw edge after a quiet spell
+} BatchDebouncer;
+
+// One confirmed edge; sample = number of the first raw edge of it
+typedef struct {
+    uint32_t sample;
+    uint8_t lane;
+    uint8_t level;       // new debounced level (0 = pressed)
+} BatchEdge;
+
+void debounceShiftInit(ShiftDebouncer *d);
+uint8_t debounceShift(ShiftDebouncer *d, uint8_t sample);
+
+void debounceIntegratorInit(IntegratorDebouncer *d);
+uint8_t debounceIntegrator(IntegratorDebouncer *d, uint8_t sample);
+
+void debounceLockoutInit(LockoutDebouncer *d);
+uint8_t debounceLockout(LockoutDebouncer *d, uint8_t sample);
+
+void debounceVerticalInit(VerticalDebouncer *d);
+uint32_t debounceVertical(VerticalDebouncer *d, uint32_t samples);
+
+void debounceBatchInit(BatchDebouncer *d, uint16_t mask);
+uint8_t debounceBatch(BatchDebouncer *d, const volatile uint16_t *samples,
+                      uint16_t count, BatchEdge *edges, uint8_t maxEdges);
+
+#endif
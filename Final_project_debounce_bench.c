@@ -0,0 +1,372 @@
+#include "debounce_bench.h"
+#include "debounce.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+#ifdef DEBOUNCE_BENCH
+
+/*=================================================================
+ * @file: debounce_bench.c
+ * @brief: Debounce strategy benchmark
+ *
+ * Each profile builds BENCH_TRIALS press/release waveforms with a
+ * known true edge time, then plays the same samples through every
+ * strategy in debounce.c. Per strategy we keep:
+ *  - detection latency (true press -> debounced press), in samples
+ *  - missed presses and false triggers (edges with no real cause)
+ *  - cycles per sample, measured with the DWT cycle counter
+ * Results are left in debounceBenchResults[] for the debugger.
+ *
+ * The synthetic profiles run at boot, before any input. The real
+ * left button is recorded from the sampler's raw stream (sampler.c)
+ * at BENCH_SAMPLE_US from its first press on; once the buffer is
+ * full, debounceBenchService() replays it as one extra profile. Its
+ * true edges are taken as the first raw edge of each transition
+ * that later stays stable for BENCH_SETTLE samples.
+ *===============================================================*/
+
+#define BENCH_IDLE     50   // released samples before and after a press
+#define BENCH_HOLD     100  // samples the button is held down
+#define BENCH_SETTLE   20   // stable samples that confirm a recorded edge
+#define BENCH_MAX_TRACE BENCH_RECORD_SAMPLES
+#define BENCH_MAX_EDGES 64
+
+// Bounce/noise description of one synthetic profile
+typedef struct {
+    uint8_t bounce;        // samples of chatter after each edge
+    uint8_t noisePermille; // chance per sample of a single-sample flip
+    uint8_t spikeEvery;    // mean samples between EMI bursts (0 = none)
+    uint8_t spikeLen;      // samples per EMI burst
+} BounceProfile;
+
+static const BounceProfile profiles[NUM_BENCH_PROFILES] = {
+    { 0,  0,  0, 0 },  // clean edges
+    { 3,  0,  0, 0 },  // short bounce
+    { 15, 0,  0, 0 },  // long bounce (worn contacts)
+    { 5,  20, 0, 0 },  // bounce + random noise
+    { 5,  2, 80, 2 }   // bounce + periodic EMI bursts
+};
+
+// A true edge in the waveform (level is the new pin level)
+typedef struct {
+    uint16_t time;
+    uint8_t level;
+    uint8_t matched;
+} BenchEdge;
+
+DebounceBenchResult debounceBenchResults[NUM_BENCH_PROFILES + 1][NUM_BENCH_STRATEGIES];
+
+NOINIT static uint8_t trace[BENCH_MAX_TRACE];
+static uint16_t traceLen;
+NOINIT static BenchEdge edges[BENCH_MAX_EDGES];
+static uint8_t numEdges;
+NOINIT static uint16_t latency[NUM_BENCH_STRATEGIES][BENCH_TRIALS];
+static uint16_t numLatency[NUM_BENCH_STRATEGIES];
+
+static uint8_t recordBuf[BENCH_RECORD_SAMPLES / 8];
+static volatile uint16_t recordCount = 0;
+static uint8_t recordedRun;
+
+static uint32_t rngState = 0x2545F491UL;
+
+/****************************************************************************
+ * benchRandom()
+ * @return: next value of a xorshift32 generator
+ * Fixed seed so every run of the bench sees the same waveforms.
+ ****************************************************************************/
+static uint32_t benchRandom(void)
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+/****************************************************************************
+ * appendEdge()
+ * @parameter: level - pin level after the edge, bounce - chatter samples
+ * Writes a true edge followed by its bounce into the trace.
+ ****************************************************************************/
+static void appendEdge(uint8_t level, uint8_t bounce)
+{
+    edges[numEdges].time = traceLen;
+    edges[numEdges].level = level;
+    edges[numEdges].matched = 0;
+    numEdges++;
+
+    for (int i = 0; i < bounce; i++)
+        trace[traceLen++] = (i == 0) ? level : (uint8_t)(benchRandom() & 1U);
+}
+
+static void appendLevel(uint8_t level, uint16_t count)
+{
+    while (count--)
+        trace[traceLen++] = level;
+}
+
+/****************************************************************************
+ * buildTrial()
+ * @parameter: p - profile to generate
+ * Fills trace[] with idle, press + bounce, hold, release + bounce, idle,
+ * then overlays EMI bursts and, on the samples outside them, noise flips.
+ ****************************************************************************/
+static void buildTrial(const BounceProfile *p)
+{
+    traceLen = 0;
+    numEdges = 0;
+
+    appendLevel(1, BENCH_IDLE);
+    appendEdge(0, p->bounce);
+    appendLevel(0, BENCH_HOLD);
+    appendEdge(1, p->bounce);
+    appendLevel(1, BENCH_IDLE);
+
+    for (uint16_t t = 0; t < traceLen; t++) {
+        if (p->spikeEvery && p->spikeLen && (benchRandom() % p->spikeEvery) == 0) {
+            uint16_t k;
+
+            // A burst covers its samples; the loop's t++ lands right after it
+            for (k = 0; k < p->spikeLen && t + k < traceLen; k++)
+                trace[t + k] ^= 1U;
+            t += k - 1;
+        }
+        else if (p->noisePermille && (benchRandom() % 1000U) < p->noisePermille) {
+            trace[t] ^= 1U;
+        }
+    }
+}
+
+/****************************************************************************
+ * buildRecorded()
+ * Copies the recorded samples into trace[] and derives the true edges.
+ ****************************************************************************/
+static void buildRecorded(void)
+{
+    uint8_t level = 1;
+    uint16_t firstEdge = 0;
+    uint16_t stable = 0;    // samples in a row that differ from level
+    uint16_t quiet = 0;     // samples in a row that match level
+    uint8_t pending = 0;
+
+    traceLen = 0;
+    numEdges = 0;
+
+    for (uint16_t t = 0; t < recordCount && t < BENCH_MAX_TRACE; t++) {
+        uint8_t s = (recordBuf[t >> 3] >> (t & 7U)) & 1U;
+        trace[traceLen++] = s;
+
+        if (s == level) {
+            stable = 0;
+            if (++quiet >= BENCH_SETTLE)
+                pending = 0;            // that was a glitch, not a transition
+            continue;
+        }
+
+        quiet = 0;
+        if (!pending) {
+            firstEdge = t;              // first raw edge of a transition
+            pending = 1;
+        }
+        if (++stable >= BENCH_SETTLE && numEdges < BENCH_MAX_EDGES) {
+            edges[numEdges].time = firstEdge;
+            edges[numEdges].level = s;
+            edges[numEdges].matched = 0;
+            numEdges++;
+            level = s;
+            stable = 0;
+            pending = 0;
+        }
+    }
+}
+
+/****************************************************************************
+ * scoreEdge()
+ * @parameter: result - entry to update, strategy - index, t - sample, level
+ * Matches a debounced edge against the most recent true edge. An edge
+ * that does not match an unclaimed true edge of the same level counts
+ * as a false trigger.
+ ****************************************************************************/
+static void scoreEdge(DebounceBenchResult *result, int strategy, uint16_t t, uint8_t level)
+{
+    int i = numEdges - 1;
+    while (i >= 0 && edges[i].time > t)
+        i--;
+
+    if (i < 0 || edges[i].level != level || (edges[i].matched & (1U << strategy))) {
+        result->falseTriggers++;
+        return;
+    }
+
+    edges[i].matched |= (uint8_t)(1U << strategy);
+    if (level == 0 && numLatency[strategy] < BENCH_TRIALS)
+        latency[strategy][numLatency[strategy]++] = (uint16_t)(t - edges[i].time);
+}
+
+/****************************************************************************
+ * runStrategies()
+ * @parameter: row - results row for the current profile
+ * Plays trace[] through every strategy, timing each one separately.
+ ****************************************************************************/
+static void runStrategies(DebounceBenchResult *row, ShiftDebouncer *shift,
+                          VerticalDebouncer *vertical, IntegratorDebouncer *integ,
+                          LockoutDebouncer *lockout, uint32_t *cycles)
+{
+    for (int s = 0; s < NUM_BENCH_STRATEGIES; s++) {
+        uint8_t prev = 1;
+
+        for (uint16_t t = 0; t < traceLen; t++) {
+            uint8_t out;
+            uint32_t start = DWT->CYCCNT;
+
+            switch (s) {
+            case BENCH_SHIFT:      out = debounceShift(shift, trace[t]); break;
+            case BENCH_VERTICAL:   out = debounceVertical(vertical, trace[t]) & 1U; break;
+            case BENCH_INTEGRATOR: out = debounceIntegrator(integ, trace[t]); break;
+            default:               out = debounceLockout(lockout, trace[t]); break;
+            }
+
+            cycles[s] += DWT->CYCCNT - start;
+
+            if (out != prev)
+                scoreEdge(&row[s], s, t, out);
+            prev = out;
+        }
+    }
+
+    for (int e = 0; e < numEdges; e++)
+        for (int s = 0; s < NUM_BENCH_STRATEGIES; s++)
+            if (edges[e].level == 0 && !(edges[e].matched & (1U << s)))
+                row[s].missed++;
+}
+
+/****************************************************************************
+ * percentile()
+ * @parameter: values - sorted latencies, n - count, pct - 0..100
+ * @return: nearest-rank percentile
+ ****************************************************************************/
+static uint16_t percentile(const uint16_t *values, uint16_t n, uint8_t pct)
+{
+    if (n == 0) return 0xFFFF;
+    uint32_t rank = ((uint32_t)pct * n + 99U) / 100U;
+    return values[rank ? rank - 1 : 0];
+}
+
+static void sortLatency(uint16_t *values, uint16_t n)
+{
+    for (uint16_t i = 1; i < n; i++) {
+        uint16_t v = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > v) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = v;
+    }
+}
+
+/****************************************************************************
+ * runProfile()
+ * @parameter: row - results row, profile - synthetic profile or 0 for
+ *             the recorded trace
+ ****************************************************************************/
+static void runProfile(DebounceBenchResult *row, const BounceProfile *profile)
+{
+    ShiftDebouncer shift;
+    VerticalDebouncer vertical;
+    IntegratorDebouncer integ;
+    LockoutDebouncer lockout;
+    uint32_t cycles[NUM_BENCH_STRATEGIES] = {0};
+    uint32_t samples = 0;
+    int trials = profile ? BENCH_TRIALS : 1;
+
+    debounceShiftInit(&shift);
+    debounceVerticalInit(&vertical);
+    debounceIntegratorInit(&integ);
+    debounceLockoutInit(&lockout);
+
+    for (int s = 0; s < NUM_BENCH_STRATEGIES; s++) {
+        row[s] = (DebounceBenchResult){0};
+        numLatency[s] = 0;
+    }
+
+    for (int trial = 0; trial < trials; trial++) {
+        if (profile)
+            buildTrial(profile);
+        else
+            buildRecorded();
+
+        runStrategies(row, &shift, &vertical, &integ, &lockout, cycles);
+        samples += traceLen;
+    }
+
+    for (int s = 0; s < NUM_BENCH_STRATEGIES; s++) {
+        sortLatency(latency[s], numLatency[s]);
+        row[s].latencyP50 = percentile(latency[s], numLatency[s], 50);
+        row[s].latencyP90 = percentile(latency[s], numLatency[s], 90);
+        row[s].latencyP99 = percentile(latency[s], numLatency[s], 99);
+        row[s].latencyMax = percentile(latency[s], numLatency[s], 100);
+        row[s].cyclesPerSample = samples ? cycles[s] / samples : 0;
+    }
+}
+
+/****************************************************************************
+ * enableCycleCounter()
+ * @parameter: None
+ * @return: None
+ ****************************************************************************/
+static void enableCycleCounter(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/****************************************************************************
+ * runDebounceBench()
+ * @parameter: None
+ * @return: None
+ * Runs every synthetic profile. Enables the DWT cycle counter if needed.
+ ****************************************************************************/
+void runDebounceBench(void)
+{
+    enableCycleCounter();
+    DWT->CYCCNT = 0;
+
+    rngState = 0x2545F491UL;
+    for (int p = 0; p < NUM_BENCH_PROFILES; p++)
+        runProfile(debounceBenchResults[p], &profiles[p]);
+}
+
+/****************************************************************************
+ * debounceBenchService()
+ * @parameter: None
+ * @return: None
+ * The recorded profile, once, as soon as the recording is full.
+ ****************************************************************************/
+void debounceBenchService(void)
+{
+    if (recordedRun || recordCount < BENCH_RECORD_SAMPLES)
+        return;
+
+    recordedRun = 1;
+    enableCycleCounter();
+    runProfile(debounceBenchResults[BENCH_PROFILE_RECORDED], 0);
+}
+
+/****************************************************************************
+ * debounceBenchRecord()
+ * @parameter: sample - raw pin level (1 = released)
+ * Bit-packs one sample into the recording buffer until it is full.
+ ****************************************************************************/
+RAMFUNC void debounceBenchRecord(uint8_t sample)
+{
+    if (recordCount >= BENCH_RECORD_SAMPLES) return;
+    if (recordCount == 0 && sample) return;     // wait for the first press
+
+    if (sample)
+        recordBuf[recordCount >> 3] |= (uint8_t)(1U << (recordCount & 7U));
+    else
+        recordBuf[recordCount >> 3] &= (uint8_t)~(1U << (recordCount & 7U));
+    recordCount++;
+}
+
+#endif
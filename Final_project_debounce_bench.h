@@ -0,0 +1,58 @@
+#ifndef DEBOUNCE_BENCH_H
+#define DEBOUNCE_BENCH_H
+
+/*************************************************
+ * @file: debounce_bench.h
+ *
+ * Header file for debounce_bench.c
+ * On-target benchmark of the strategies in debounce.c against
+ * synthetic and recorded contact-bounce waveforms. Only built with
+ * -DDEBOUNCE_BENCH.
+ *************************************************/
+
+#include <stdint.h>
+
+// Strategies under test (index into debounceBenchResults)
+#define BENCH_SHIFT       0
+#define BENCH_VERTICAL    1
+#define BENCH_INTEGRATOR  2
+#define BENCH_LOCKOUT     3
+#define NUM_BENCH_STRATEGIES 4
+
+// Waveform profiles (index into the profile table in debounce_bench.c)
+#define NUM_BENCH_PROFILES 5
+#define BENCH_PROFILE_RECORDED NUM_BENCH_PROFILES  // extra slot for a captured trace
+
+#define BENCH_TRIALS        64   // presses per profile
+#define BENCH_SAMPLE_US     1000 // virtual time between samples
+#define BENCH_RECORD_SAMPLES 4096
+#define BENCH_RECORD_PIN    1    // PC1 (BTN_LEFT) is the one recorded
+
+// Results of one strategy on one profile. Latencies are in samples.
+typedef struct {
+    uint16_t latencyP50;
+    uint16_t latencyP90;
+    uint16_t latencyP99;
+    uint16_t latencyMax;
+    uint16_t missed;          // presses never reported
+    uint16_t falseTriggers;   // reported edges that were not a press/release
+    uint32_t cyclesPerSample; // DWT cycles per call, averaged
+} DebounceBenchResult;
+
+#ifdef DEBOUNCE_BENCH
+extern DebounceBenchResult debounceBenchResults[NUM_BENCH_PROFILES + 1][NUM_BENCH_STRATEGIES];
+
+// Run every strategy over every synthetic profile
+void runDebounceBench(void);
+
+// Append one raw sample, BENCH_SAMPLE_US after the last, to the
+// recording. Recording starts at the first pressed sample. Called
+// from the sampler's DMA interrupt.
+void debounceBenchRecord(uint8_t sample);
+
+// Runs the recorded profile once the recording is full (call from
+// a task; does nothing before that, or after it has run)
+void debounceBenchService(void);
+#endif
+
+#endif
@@ -0,0 +1,170 @@
+#include "flash_port.h"
+#include "stm32l476xx.h"
+
+/*=================================================================
+ * @file: flash_port.c
+ * @brief: STM32L476 flash controller port for the persistent store
+ *
+ * The store pages are in bank 2 and the firmware runs from bank 1.
+ * With the dual-bank layout (the DUALBANK default on 1 MB parts),
+ * an erase or program in bank 2 does not stall code fetches from
+ * bank 1, so the game keeps running while a 22 ms page erase is in
+ * progress.
+ *
+ * Programming is 64 bits at a time: two word writes to the same
+ * double-word with PG set. After an erase the flash data cache may
+ * still hold old lines from the page, so it is reset.
+ *
+ * Each double-word carries its own ECC. One cut short by a power
+ * loss can fail it with a double error, and the L4 raises an NMI on
+ * the read. flashPortRead() marks its reads so NMI_Handler() can
+ * tell that case from any other NMI; the read then returns
+ * FLASH_PORT_UNREADABLE and the store skips the slot.
+ *===============================================================*/
+
+#define FLASH_KEY1 0x45670123UL
+#define FLASH_KEY2 0xCDEF89ABUL
+
+#define FLASH_SR_ERRORS (FLASH_SR_OPERR | FLASH_SR_PROGERR | FLASH_SR_WRPERR | \
+                         FLASH_SR_PGAERR | FLASH_SR_SIZERR | FLASH_SR_PGSERR | \
+                         FLASH_SR_MISERR | FLASH_SR_FASTERR)
+
+static volatile uint8_t opRunning;
+static volatile uint8_t opWasErase;
+static volatile uint32_t lastError;
+static volatile uint8_t readProbe;     // flashPortRead() in progress
+static volatile uint8_t readFailed;    // ECC double error in that read
+
+/****************************************************************************
+ * unlockFlash()
+ * @parameter: None
+ * @return: None
+ * Unlocks FLASH->CR and clears old error flags.
+ ****************************************************************************/
+static void unlockFlash(void)
+{
+    if (FLASH->CR & FLASH_CR_LOCK) {
+        FLASH->KEYR = FLASH_KEY1;
+        FLASH->KEYR = FLASH_KEY2;
+    }
+    FLASH->SR = FLASH_SR_ERRORS | FLASH_SR_EOP;    // write 1 to clear
+}
+
+/****************************************************************************
+ * resetDataCache()
+ * @parameter: None
+ * @return: None
+ * The data cache can only be reset while it is disabled.
+ ****************************************************************************/
+static void resetDataCache(void)
+{
+    FLASH->ACR &= ~FLASH_ACR_DCEN;
+    FLASH->ACR |= FLASH_ACR_DCRST;
+    FLASH->ACR &= ~FLASH_ACR_DCRST;
+    FLASH->ACR |= FLASH_ACR_DCEN;
+}
+
+/****************************************************************************
+ * flashPortBusy()
+ * @parameter: None
+ * @return: 1 while the operation runs, 0 once it is finished
+ ****************************************************************************/
+int flashPortBusy(void)
+{
+    if (FLASH->SR & FLASH_SR_BSY)
+        return 1;
+
+    if (opRunning) {
+        lastError = FLASH->SR & FLASH_SR_ERRORS;
+        FLASH->CR &= ~(FLASH_CR_PG | FLASH_CR_PER | FLASH_CR_BKER);
+        FLASH->SR = FLASH_SR_ERRORS | FLASH_SR_EOP;
+        FLASH->CR |= FLASH_CR_LOCK;
+        if (opWasErase)
+            resetDataCache();
+        opRunning = 0;
+    }
+    return 0;
+}
+
+/****************************************************************************
+ * flashPortError()
+ * @parameter: None
+ * @return: FLASH_SR error flags of the last finished operation
+ ****************************************************************************/
+int flashPortError(void)
+{
+    uint32_t error = lastError;
+    lastError = 0;
+    return (int)error;
+}
+
+/****************************************************************************
+ * flashPortStartErase()
+ * @parameter: page - store page, 0..STORE_NUM_PAGES-1
+ * @return: None
+ ****************************************************************************/
+void flashPortStartErase(uint32_t page)
+{
+    unlockFlash();
+
+    FLASH->CR = (FLASH->CR & ~(FLASH_CR_PG | FLASH_CR_PNB_Msk)) |
+                FLASH_CR_PER | FLASH_CR_BKER |
+                ((STORE_FIRST_PAGE + page) << FLASH_CR_PNB_Pos);
+    opWasErase = 1;
+    opRunning = 1;
+    FLASH->CR |= FLASH_CR_STRT;
+}
+
+/****************************************************************************
+ * flashPortStartProgram()
+ * @parameter: offset - double-word aligned, lo/hi - the two words
+ * @return: None
+ ****************************************************************************/
+void flashPortStartProgram(uint32_t offset, uint32_t lo, uint32_t hi)
+{
+    volatile uint32_t *dst = (volatile uint32_t *)(STORE_BASE + offset);
+
+    unlockFlash();
+
+    FLASH->CR = (FLASH->CR & ~(FLASH_CR_PER | FLASH_CR_BKER)) | FLASH_CR_PG;
+    opWasErase = 0;
+    opRunning = 1;
+    dst[0] = lo;
+    dst[1] = hi;               // second word starts the program
+}
+
+/****************************************************************************
+ * flashPortRead()
+ * @parameter: offset - word aligned
+ * @return: the word at that offset
+ ****************************************************************************/
+uint32_t flashPortRead(uint32_t offset)
+{
+    uint32_t word;
+
+    readFailed = 0;
+    readProbe = 1;
+    word = *(const volatile uint32_t *)(STORE_BASE + offset);
+    __DSB();                   // the NMI, if any, is taken here
+    readProbe = 0;
+
+    return readFailed ? FLASH_PORT_UNREADABLE : word;
+}
+
+/****************************************************************************
+ * NMI_Handler()
+ * @parameter: None
+ * @return: None
+ * An ECC double error in a store read is cleared and reported to
+ * flashPortRead(). Any other NMI spins like Default_Handler.
+ ****************************************************************************/
+void NMI_Handler(void)
+{
+    if (readProbe && (FLASH->ECCR & FLASH_ECCR_ECCD)) {
+        FLASH->ECCR = (FLASH->ECCR & FLASH_ECCR_ECCIE) | FLASH_ECCR_ECCD;  // write 1 to clear
+        readFailed = 1;
+        return;
+    }
+    while (1)
+        ;
+}
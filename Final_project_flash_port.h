@@ -0,0 +1,42 @@
+#ifndef FLASH_PORT_H
+#define FLASH_PORT_H
+
+/*************************************************
+ * @file: flash_port.h
+ *
+ * Header file for flash_port.c
+ * Flash controller access for the persistent store (store.c).
+ * Erase and program only start the operation; flashPortBusy()
+ * reports when it is done, so nothing here ever waits on the
+ * flash. Offsets are bytes from the start of the store region.
+ *
+ * The same interface is implemented on the host by
+ * tools/flash_port_file.c, backed by an image file.
+ *************************************************/
+
+#include <stdint.h>
+
+// Last STORE_NUM_PAGES pages of bank 2, kept out of FLASH in the linker script
+#define STORE_BASE        0x080FE000UL
+#define STORE_PAGE_SIZE   2048
+#define STORE_NUM_PAGES   4
+#define STORE_FIRST_PAGE  252            // page number within bank 2
+#define STORE_SIZE        (STORE_PAGE_SIZE * STORE_NUM_PAGES)
+
+// Returns 1 while an erase/program is running. When it finishes, the
+// controller is locked again and any error is latched for flashPortError().
+int flashPortBusy(void);
+
+// Error flags of the last finished operation (0 = ok), cleared by reading
+int flashPortError(void);
+
+void flashPortStartErase(uint32_t page);
+void flashPortStartProgram(uint32_t offset, uint32_t lo, uint32_t hi);
+
+// A word whose double-word fails ECC (a program cut short) reads as
+// FLASH_PORT_UNREADABLE, which is neither erased nor a valid record
+#define FLASH_PORT_UNREADABLE 0x00000000UL
+
+uint32_t flashPortRead(uint32_t offset);
+
+#endif
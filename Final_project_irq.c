@@ -0,0 +1,128 @@
+#include "irq.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: irq.c
+ * @brief: Interrupt priorities and deferred work
+ *
+ * SysTick and the button sampler record their entry latency and
+ * period jitter here. SysTick then hands the game step to PendSV with
+ * irqTickDefer(). PendSV runs at the lowest priority, so a long
+ * game step (or LED commit) can be preempted by input sampling
+ * and by the next tick, but never delays them. A step that is still
+ * unfinished when the next tick comes is counted as an overrun: that
+ * tick's step is merged into it and lost.
+ *===============================================================*/
+
+volatile IrqStats irqStats[NUM_IRQ_STATS];
+
+static volatile uint32_t pendTime;
+
+/****************************************************************************
+ * configureInterruptPriorities()
+ * @parameter: None
+ * @return: None
+ * Applies the priority plan in irq.h. Call before the interrupts are
+ * enabled.
+ ****************************************************************************/
+void configureInterruptPriorities(void)
+{
+    NVIC_SetPriority(EXTI0_IRQn,      IRQ_PRIO_INPUT);
+    NVIC_SetPriority(EXTI1_IRQn,      IRQ_PRIO_INPUT);
+    NVIC_SetPriority(EXTI15_10_IRQn,  IRQ_PRIO_INPUT);
+    NVIC_SetPriority(TIM2_IRQn,       IRQ_PRIO_INPUT);
+    NVIC_SetPriority(DMA1_Channel6_IRQn, IRQ_PRIO_INPUT);   // button sampler
+    NVIC_SetPriority(DMA1_Channel1_IRQn, IRQ_PRIO_INPUT);   // analog paddles
+    NVIC_SetPriority(TIM1_BRK_TIM15_IRQn, IRQ_PRIO_INPUT);  // keypad scan
+    NVIC_SetPriority(SysTick_IRQn,    IRQ_PRIO_TIMEBASE);
+    NVIC_SetPriority(TIM7_IRQn,       IRQ_PRIO_TIMEBASE);     // LED bit-planes
+    NVIC_SetPriority(USART1_IRQn,     IRQ_PRIO_TIMEBASE);     // board link
+    NVIC_SetPriority(TIM5_IRQn,       IRQ_PRIO_TIMEBASE);     // scheduler wake-up
+    NVIC_SetPriority(DMA1_Channel3_IRQn, IRQ_PRIO_TIMEBASE);  // sound effect end
+    NVIC_SetPriority(PendSV_IRQn,     IRQ_PRIO_DEFERRED);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/****************************************************************************
+ * irqStatsSetPeriod()
+ * @parameter: slot - IRQ_STAT_*, period - expected cycles between entries
+ * @return: None
+ ****************************************************************************/
+void irqStatsSetPeriod(uint8_t slot, uint32_t period)
+{
+    irqStats[slot].period = period;
+    irqStats[slot].lastEntry = 0;    // next entry starts a new baseline
+}
+
+/****************************************************************************
+ * irqStatsEntry()
+ * @parameter: slot - IRQ_STAT_*, latency - cycles from event to entry
+ * @return: None
+ * Tracks the worst latency, and for periodic slots the worst deviation
+ * of the measured period from the programmed one, late entries and
+ * periods that were skipped altogether.
+ ****************************************************************************/
+RAMFUNC void irqStatsEntry(uint8_t slot, uint32_t latency)
+{
+    volatile IrqStats *s = &irqStats[slot];
+    uint32_t now = TIM5->CNT;
+
+    s->latencyLast = latency;
+    if (latency > s->latencyMax)
+        s->latencyMax = latency;
+
+    if (s->period && s->lastEntry) {
+        uint32_t period = s->period;
+        uint32_t measured = now - s->lastEntry;
+        uint32_t jitter = (measured > period) ? measured - period
+                                              : period - measured;
+        if (jitter > s->jitterMax)
+            s->jitterMax = jitter;
+
+        if (measured > period + period / IRQ_LATE_DIV) {
+            s->late++;
+            s->missed += (measured + period / 2) / period - 1;
+        }
+    }
+
+    s->lastEntry = now;
+    s->count++;
+}
+
+/****************************************************************************
+ * deferToPendSV()
+ * @parameter: None
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void deferToPendSV(void)
+{
+    pendTime = DWT->CYCCNT;
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+/****************************************************************************
+ * irqTickDefer()
+ * @parameter: slot - IRQ_STAT_* of the calling tick
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void irqTickDefer(uint8_t slot)
+{
+    if ((SCB->ICSR & SCB_ICSR_PENDSVSET_Msk) ||
+        (SCB->SHCSR & SCB_SHCSR_PENDSVACT_Msk))
+        irqStats[slot].overruns++;
+
+    deferToPendSV();
+}
+
+/****************************************************************************
+ * irqDeferredEntry()
+ * @parameter: None
+ * @return: None
+ * Records how long the bottom half waited behind higher priority work.
+ ****************************************************************************/
+RAMFUNC void irqDeferredEntry(void)
+{
+    irqStatsEntry(IRQ_STAT_PENDSV, DWT->CYCCNT - pendTime);
+}
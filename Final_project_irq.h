@@ -0,0 +1,75 @@
+#ifndef IRQ_H
+#define IRQ_H
+
+/*************************************************
+ * @file: irq.h
+ *
+ * Header file for irq.c
+ * Interrupt priority plan and preemption/jitter measurement.
+ *
+ * Priorities (0 = most urgent, 4 bits on the L476):
+ *   input   - button edges, debounce sampling, keypad scan and
+ *             analog paddles (EXTI, DMA1 channel 6 or TIM2,
+ *             TIM15, DMA1 channel 1)
+ *   time    - game time base (SysTick), only pends the bottom half,
+ *             and the LED bit-plane timer (TIM7), which is short.
+ *             The board link UART (USART1) shares it: one byte per
+ *             entry, and a byte arrives every 87 us. TIM5 compares
+ *             wake the scheduler (sched.c) and pend the tickless
+ *             game events (tickless.c)
+ *   deferred- PendSV bottom half: game logic and LED commits
+ * Input sampling can preempt everything else, and nothing the
+ * game or the LEDs do can delay it.
+ *************************************************/
+
+#include "stm32l476xx.h"
+
+#define IRQ_PRIO_INPUT    0
+#define IRQ_PRIO_TIMEBASE 1
+#define IRQ_PRIO_DEFERRED 15
+
+// Measurement slots
+#define IRQ_STAT_SYSTICK 0
+#define IRQ_STAT_INPUT   1   // button sampling (sampler.c, or TIM2)
+#define IRQ_STAT_PENDSV  2
+#define NUM_IRQ_STATS    3
+
+// A periodic entry this much (1/8 period) past its time is late
+#define IRQ_LATE_DIV      8
+
+// All values in core cycles. Periods are timed on TIM5, which keeps
+// counting while the core sleeps (DWT does not); at 4 MHz both
+// count the same.
+typedef struct {
+    uint32_t period;      // expected cycles between entries (0 = not periodic)
+    uint32_t lastEntry;   // TIM5->CNT at the last entry
+    uint32_t latencyLast; // event -> handler entry
+    uint32_t latencyMax;
+    uint32_t jitterMax;   // worst |measured period - expected period|
+    uint32_t count;
+    uint32_t late;        // entries more than period/IRQ_LATE_DIV late
+    uint32_t missed;      // whole periods that passed without an entry
+    uint32_t overruns;    // ticks that found the last bottom half unfinished
+} IrqStats;
+
+extern volatile IrqStats irqStats[NUM_IRQ_STATS];
+
+void configureInterruptPriorities(void);
+
+// Set the expected period of a periodic interrupt and restart its jitter baseline
+void irqStatsSetPeriod(uint8_t slot, uint32_t period);
+
+// Record one handler entry with its measured latency
+void irqStatsEntry(uint8_t slot, uint32_t latency);
+
+// Pend the PendSV bottom half, and record it for its latency measurement
+void deferToPendSV(void);
+
+// deferToPendSV() for a periodic tick (slot): if the bottom half of
+// the previous tick is still pending or running, counts an overrun
+void irqTickDefer(uint8_t slot);
+
+// Call first thing in PendSV_Handler
+void irqDeferredEntry(void);
+
+#endif
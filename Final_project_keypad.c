@@ -0,0 +1,173 @@
+#include "keypad.h"
+#include "debounce.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: keypad.c
+ * @brief: Timer-driven key matrix scanner
+ *
+ * TIM15 interrupts KEYPAD_ROW_RATE times a second. Each interrupt
+ * reads the columns for the row that was driven by the previous
+ * interrupt, so the row has a full period to settle and there is no
+ * busy-wait. It then releases that row and drives the next one.
+ * The cost is one interrupt and one IDR read per row, whatever the
+ * number of columns.
+ *
+ * After the last row the frame is checked for ghosting, then all
+ * keys go through one vertical-counter debouncer (debounce.c):
+ * 4 equal frames (16 ms) to change state, for every key at once.
+ *
+ * Ghosting: with no diodes, three keys at three corners of a
+ * rectangle also close the fourth corner. Two rows that share two
+ * or more pressed columns cannot be told apart from that, so the
+ * frame is dropped and the last good frame is used again.
+ *
+ * This is the scanner only: no game mode reads the keys yet. A
+ * consumer takes them with keypadTakeEdges() or reads keypad.state.
+ *===============================================================*/
+
+#define KEYPAD_TIMER_CLK  4000000   // TIM15 kernel clock (MSI)
+#define KEYPAD_COL_SHIFT  4         // columns are PB4..PB7
+#define KEYPAD_COL_MASK   ((1UL << KEYPAD_COLS) - 1)
+
+static const uint8_t rowPins[KEYPAD_ROWS] = {6, 7, 8, 11};   // GPIOA
+
+Keypad keypad;
+
+static VerticalDebouncer debouncer;
+static uint8_t scanRow;
+static uint32_t scanRaw;       // pressed keys of the frame being scanned (1 = down)
+static uint32_t lastGood;      // last frame without ghosting
+
+/****************************************************************************
+ * init_Keypad()
+ * @parameter: None
+ * @return: None
+ * Rows as open-drain outputs (released = high-Z), columns as inputs
+ * with pull-ups, then TIM15 started with row 0 driven.
+ ****************************************************************************/
+void init_Keypad(void)
+{
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN | RCC_AHB2ENR_GPIOBEN;
+    RCC->APB2ENR |= RCC_APB2ENR_TIM15EN;
+
+    for (int r = 0; r < KEYPAD_ROWS; r++) {
+        uint32_t pin = rowPins[r];
+        GPIOA->BSRR = (1UL << pin);                 // released
+        GPIOA->OTYPER |= (1UL << pin);              // open-drain
+        GPIOA->PUPDR &= ~(3UL << (pin * 2));
+        GPIOA->MODER = (GPIOA->MODER & ~(3UL << (pin * 2))) | (1UL << (pin * 2));
+    }
+
+    for (int c = 0; c < KEYPAD_COLS; c++) {
+        uint32_t pin = KEYPAD_COL_SHIFT + c;
+        GPIOB->MODER &= ~(3UL << (pin * 2));         // input
+        GPIOB->PUPDR = (GPIOB->PUPDR & ~(3UL << (pin * 2))) | (1UL << (pin * 2));
+    }
+
+    debounceVerticalInit(&debouncer);
+    keypad.state = KEYPAD_ALL;
+    keypad.pressed = 0;
+    keypad.released = 0;
+    scanRow = 0;
+    scanRaw = 0;
+    lastGood = 0;
+
+    GPIOA->BSRR = (1UL << rowPins[0]) << 16;        // drive row 0
+
+    TIM15->PSC = 0;
+    TIM15->ARR = (KEYPAD_TIMER_CLK / KEYPAD_ROW_RATE) - 1;
+    TIM15->DIER |= TIM_DIER_UIE;
+    NVIC_EnableIRQ(TIM1_BRK_TIM15_IRQn);
+    TIM15->CR1 |= TIM_CR1_CEN;
+}
+
+/****************************************************************************
+ * isGhosted()
+ * @parameter: raw - pressed keys of one frame (1 = down)
+ * @return: 1 if two rows share two or more pressed columns
+ ****************************************************************************/
+static RAMFUNC int isGhosted(uint32_t raw)
+{
+    for (int a = 0; a < KEYPAD_ROWS - 1; a++) {
+        uint32_t rowA = (raw >> (a * KEYPAD_COLS)) & KEYPAD_COL_MASK;
+        if ((rowA & (rowA - 1)) == 0)
+            continue;                               // fewer than 2 keys
+
+        for (int b = a + 1; b < KEYPAD_ROWS; b++) {
+            uint32_t common = rowA & (raw >> (b * KEYPAD_COLS));
+            common &= KEYPAD_COL_MASK;
+            if (common & (common - 1))
+                return 1;
+        }
+    }
+    return 0;
+}
+
+/****************************************************************************
+ * scanFrame()
+ * @parameter: raw - pressed keys of the finished frame (1 = down)
+ * @return: None
+ * Ghost check, debounce, then accumulate edges.
+ ****************************************************************************/
+static RAMFUNC void scanFrame(uint32_t raw)
+{
+    uint32_t old = keypad.state;
+    uint32_t now;
+
+    if (isGhosted(raw)) {
+        keypad.ghosts++;
+        raw = lastGood;
+    }
+    lastGood = raw;
+
+    // Debouncer works in the buttons[] sense: 1 = released
+    now = debounceVertical(&debouncer, ~raw) & KEYPAD_ALL;
+
+    keypad.pressed  |= (old ^ now) & ~now;
+    keypad.released |= (old ^ now) & now;
+    keypad.state = now;
+    keypad.frames++;
+}
+
+/****************************************************************************
+ * TIM1_BRK_TIM15_IRQHandler()
+ * @parameter: None
+ * @return: None
+ * Reads the driven row, moves on to the next one.
+ ****************************************************************************/
+RAMFUNC void TIM1_BRK_TIM15_IRQHandler(void)
+{
+    uint32_t cols;
+
+    TIM15->SR = ~TIM_SR_UIF;     // rc_w0: a plain write clears only UIF
+
+    cols = ~(GPIOB->IDR >> KEYPAD_COL_SHIFT) & KEYPAD_COL_MASK;
+    scanRaw |= cols << (scanRow * KEYPAD_COLS);
+
+    GPIOA->BSRR = (1UL << rowPins[scanRow]);        // release this row
+    if (++scanRow == KEYPAD_ROWS) {
+        scanRow = 0;
+        scanFrame(scanRaw);
+        scanRaw = 0;
+    }
+    GPIOA->BSRR = (1UL << rowPins[scanRow]) << 16;  // drive the next one
+}
+
+/****************************************************************************
+ * keypadTakeEdges()
+ * @parameter: pressed, released - filled with the edges since the last call
+ * @return: None
+ ****************************************************************************/
+void keypadTakeEdges(uint32_t *pressed, uint32_t *released)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *pressed = keypad.pressed;
+    *released = keypad.released;
+    keypad.pressed = 0;
+    keypad.released = 0;
+    __set_PRIMASK(primask);
+}
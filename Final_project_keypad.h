@@ -0,0 +1,43 @@
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+/*************************************************
+ * @file: keypad.h
+ *
+ * Header file for keypad.c
+ * 4x4 key matrix, meant for extra players and menu controls (only
+ * the scanner so far: nothing reads the keys yet). Rows are
+ * driven one at a time from a timer interrupt, columns are read
+ * with one IDR read per row, and all keys are debounced together.
+ *
+ * Key n is bit n of every mask: n = row * KEYPAD_COLS + column.
+ * Like buttons[], a state bit is 0 while pressed, 1 when released.
+ *************************************************/
+
+#include <stdint.h>
+
+#define KEYPAD_ROWS      4   // PA6, PA7, PA8, PA11 (open-drain, low = active)
+#define KEYPAD_COLS      4   // PB4..PB7 (pull-up, low = key down)
+#define KEYPAD_KEYS      (KEYPAD_ROWS * KEYPAD_COLS)
+#define KEYPAD_ALL       ((1UL << KEYPAD_KEYS) - 1)
+
+#define KEYPAD_ROW_RATE  1000  // row interrupts per second (frame = 4 ms)
+
+#define KEYPAD_KEY(row, col) ((row) * KEYPAD_COLS + (col))
+
+typedef struct {
+    volatile uint32_t state;      // debounced, 0 = pressed
+    volatile uint32_t pressed;    // press edges since the last keypadTakeEdges()
+    volatile uint32_t released;   // release edges since the last keypadTakeEdges()
+    volatile uint32_t frames;     // complete scans
+    volatile uint32_t ghosts;     // scans dropped as ambiguous
+} Keypad;
+
+extern Keypad keypad;
+
+void init_Keypad(void);
+
+// Returns and clears the accumulated edge masks
+void keypadTakeEdges(uint32_t *pressed, uint32_t *released);
+
+#endif
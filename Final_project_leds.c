@@ -1,5 +1,10 @@
 #include "led_setup.h"
 #include "stm32l476xx.h"
+#include "memmap.h"
+#include "matrix.h"
+#include "brightness.h"
+#include "coro.h"
+#include "swtimer.h"
 
 /*=================================================================
  * @file: led_setup.c
@@ -10,15 +15,63 @@
  * It configures PC5–PC12 for the playfield, and uses PC14, PC15,
  * PH0 (Player 1 score) and PH1, PC2, PC3 (Player 2 score).
  * Functions also include LED shifting logic and serving logic.
+ * The playfield is mirrored onto MATRIX_COURT_ROW of the 8x8
+ * matrix (matrix.c), so everything written through
+ * update_LEDs_PC5to12()/setLedPattern() shows on both.
+ * Once init_Brightness() has run, the LEDs are driven through the
+ * brightness engine (brightness.c) instead of ODR, which adds the
+ * ball trail and the winner's score pulse.
+ * The winner flash is a coroutine (coro.h) stepped by a periodic
+ * software timer (swtimer.h) that only exists while it runs, so it
+ * never holds up the game step or the main loop. The game step
+ * (PendSV) starts and stops it while the timers task steps it, so
+ * both sides run with PRIMASK set, and every start gets a new
+ * generation: a step timerService() picked up for an earlier flash
+ * finds another generation and does nothing.
  *===============================================================*/
 
 #define PLAY_MODE 0
 #define FLASH_LED_MODE 1
 
-volatile uint8_t ledPattern = 0x01;
-volatile uint8_t led_mode = PLAY_MODE;
+SRAM2_DATA volatile uint8_t ledPattern = 0x01;
+SRAM2_DATA volatile uint8_t led_mode = PLAY_MODE;
 volatile uint8_t currentServer = 1;  // 1 = Player 1, 0 = Player 2
 
+#define FLASH_TOGGLES 18                 // 9 flashes
+
+static Coro flashCo;
+static SoftTimer *volatile flashTimer;
+static volatile uint8_t flashWinner;    // 0 = no flash running
+static volatile uint8_t flashGen;       // bumped by every start and stop
+static uint8_t shownScore[2];           // last score drawn per player
+static uint8_t flashCount;
+
+static void flashStep(void *arg);
+static void flashEnd(void);
+
+/***************************************************************************
+ * configureOutputs()
+ * @parameter: port - GPIO port, pins - bit n set for pin n
+ * @return: None
+ * Push-pull, low speed, no pull outputs for all the given pins.
+ ***************************************************************************/
+static void configureOutputs(GPIO_TypeDef *port, uint32_t pins)
+{
+    uint32_t modeMask = 0, modeOut = 0;
+
+    for (int pin = 0; pin < 16; pin++) {
+        if (pins & (1UL << pin)) {
+            modeMask |= 3UL << (pin * 2);
+            modeOut  |= 1UL << (pin * 2);
+        }
+    }
+
+    port->MODER   = (port->MODER & ~modeMask) | modeOut;
+    port->OTYPER  &= ~pins;
+    port->OSPEEDR &= ~modeMask;
+    port->PUPDR   &= ~modeMask;
+}
+
 /***************************************************************************
  * init_LEDs_PC5to12()
  * @paramters: None
@@ -27,64 +80,28 @@ volatile uint8_t currentServer = 1;  // 1 = Player 1, 0 = Player 2
  * and the score LEDs for both players.
  ***************************************************************************/
 void init_LEDs_PC5to12(void)
-{   //------------Enable all clocks----------------
-    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOCEN;
-    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOBEN;
-    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN;
-    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOHEN;
-
-    // --- Playfield LEDs: PC5–PC12 ---
-    for (int pin = 5; pin <= 12; pin++) {
-   GPIOC->MODER   &= ~(3UL << (pin * 2));
-   GPIOC->MODER   |=  (1UL << (pin * 2));
-   GPIOC->OTYPER  &= ~(1UL << pin);
-   GPIOC->OSPEEDR &= ~(3UL << (pin * 2));
-    GPIOC->PUPDR   &= ~(3UL << (pin * 2));
-    }
+{
+    // Pins per port: one read-modify-write per register instead of one per pin
+    const uint32_t pinsC = (0xFFUL << 5) | (1UL << 2) | (1UL << 3); // playfield, P2 score
+    const uint32_t pinsB = (1UL << 8) | (1UL << 9);                  // P1 score
+    const uint32_t pinsH = (1UL << 0) | (1UL << 1);                  // P1, P2 score
+    const uint32_t pinsA = (1UL << 5);                               // user LED LD2
+
+    //------------Enable all clocks (one write)----------------
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN | RCC_AHB2ENR_GPIOBEN |
+                    RCC_AHB2ENR_GPIOCEN | RCC_AHB2ENR_GPIOHEN;
+
+    // --- Playfield LEDs: PC5–PC12, Player 2(Red) Score: PC2, PC3 ---
+    configureOutputs(GPIOC, pinsC);
 
-    // --- Player 1(Blue) Score: PC14, PC15, PH0 ---
-    GPIOB->MODER &= ~(3UL << (8 * 2));
-    GPIOB->MODER |=  (1UL << (8 * 2));
-    GPIOB->OTYPER &= ~(1UL << 8);
-    GPIOB->OSPEEDR &= ~(3UL << (8 * 2));
-    GPIOB->PUPDR &= ~(3UL << (8 * 2));
-
-    GPIOB->MODER &= ~(3UL << (9 * 2));
-    GPIOB->MODER |=  (1UL << (9 * 2));
-    GPIOB->OTYPER &= ~(1UL << 9);
-    GPIOB->OSPEEDR &= ~(3UL << (9 * 2));
-    GPIOB->PUPDR &= ~(3UL << (9 * 2));
-
-    GPIOH->MODER &= ~(3UL << (0 * 2));
-    GPIOH->MODER |=  (1UL << (0 * 2));
-    GPIOH->OTYPER  &= ~(1UL << 0);
-    GPIOH->OSPEEDR &= ~(3UL << (0 * 2));
-    GPIOH->PUPDR   &= ~(3UL << (0 * 2));
-
-    // --- Player 2(Red) Score: PH1, PC2, PC3 ---
-    GPIOH->MODER &= ~(3UL << (1 * 2));
-    GPIOH->MODER |=  (1UL << (1 * 2));
-    GPIOH->OTYPER  &= ~(1UL << 1);
-    GPIOH->OSPEEDR &= ~(3UL << (1 * 2));
-    GPIOH->PUPDR   &= ~(3UL << (1 * 2));
-
-    GPIOC->MODER &= ~(3UL << (2 * 2));
-    GPIOC->MODER |=  (1UL << (2 * 2));
-    GPIOC->OTYPER  &= ~(1UL << 2);
-    GPIOC->OSPEEDR &= ~(3UL << (2 * 2));
-    GPIOC->PUPDR   &= ~(3UL << (2 * 2));
-
-    GPIOC->MODER &= ~(3UL << (3 * 2));
-    GPIOC->MODER |=  (1UL << (3 * 2));
-    GPIOC->OTYPER  &= ~(1UL << 3);
-    GPIOC->OSPEEDR &= ~(3UL << (3 * 2));
-    GPIOC->PUPDR   &= ~(3UL << (3 * 2));
+    // --- Player 1(Blue) Score: PB8, PB9 (and PH0 below) ---
+    configureOutputs(GPIOB, pinsB);
+
+    // --- PH0 (Player 1) and PH1 (Player 2) ---
+    configureOutputs(GPIOH, pinsH);
 
     // ----Configure user LED (LD2 -> Port A, bit 5)-------------------------
-    GPIOA->MODER = (GPIOA->MODER & ~GPIO_MODER_MODE5) | GPIO_MODER_MODE5_0; // output pin (PA5=01)
-    GPIOA->OTYPER &= ~(GPIO_OTYPER_OT5); // push-pull (PA5=0)
-    GPIOA->OSPEEDR &= ~(GPIO_OSPEEDR_OSPEED5); // low speed (PA5=00)
-    GPIOA->PUPDR &= ~(GPIO_PUPDR_PUPD5); // 
+    configureOutputs(GPIOA, pinsA);
 }
 
 /****************************************************************************
@@ -92,11 +109,19 @@ void init_LEDs_PC5to12(void)
  *  @paramter: None
  * @return: None
  * Updates the playfield LEDs using the current ledPattern.
+ * Also updates the court row of the LED matrix.
 ****************************************************************************/
-void update_LEDs_PC5to12(void)
+RAMFUNC void update_LEDs_PC5to12(void)
 {
-    GPIOC->ODR &= ~(0xFF << 5);  // Clear PC5–PC12
-    GPIOC->ODR |= ((ledPattern & 0xFF) << 5);  // Set new pattern
+    if (brightnessActive) {
+        for (int i = 0; i < 8; i++)
+            brightnessSetOn(BRIGHT_PLAYFIELD + i, (ledPattern >> i) & 1);
+    }
+    else {
+        GPIOC->ODR &= ~(0xFF << 5);  // Clear PC5–PC12
+        GPIOC->ODR |= ((ledPattern & 0xFF) << 5);  // Set new pattern
+    }
+    matrixSetRow(MATRIX_COURT_ROW, ledPattern);
 }
 
 /****************************************************************************
@@ -106,7 +131,7 @@ void update_LEDs_PC5to12(void)
  *          0 if already at the rightmost led and no shift occured.
  * Shifts the ball one LED to the right. Returns 0 if at end.
  ****************************************************************************/
-int shiftRight(void)
+RAMFUNC int shiftRight(void)
 {
     if (ledPattern == 0x01) return 0;
     ledPattern >>= 1;
@@ -121,7 +146,7 @@ int shiftRight(void)
             0 if already at the leftmost led and no shift occured.
  * Shifts the ball one LED to the left. Returns 0 if at end.
 ****************************************************************************/
-int shiftLeft(void)
+RAMFUNC int shiftLeft(void)
 {
     if (ledPattern == 0x80) return 0;
     ledPattern <<= 1;
@@ -135,7 +160,7 @@ int shiftLeft(void)
  * @parameter: None
  * Places the LED ball at the starting position based on the server.
  ****************************************************************************/
-void serve(void)
+RAMFUNC void serve(void)
 {
     if (currentServer == 1) {
         ledPattern = 0x01;  // Player 1 serve from left
@@ -151,8 +176,18 @@ void serve(void)
  * @return: None
  * Flash LEDs for the score of the player that won 3 matches.
  ****************************************************************************/
-void updatePlayerScore(uint8_t score, uint8_t player)
+RAMFUNC void updatePlayerScore(uint8_t score, uint8_t player)
 {
+    if (player == 1 || player == 2)
+        shownScore[player - 1] = score;     // what a flash restores
+
+    if (brightnessActive && (player == 1 || player == 2)) {
+        uint8_t first = (player == 1) ? BRIGHT_P1_SCORE : BRIGHT_P2_SCORE;
+        for (uint8_t i = 0; i < 3; i++)
+            brightnessSetOn(first + i, score > i);
+        return;
+    }
+
     if (player == 1) {
         // Player 1 Score LEDs: PB8, PB9, PH0
         GPIOB->ODR &= ~((1 << 8) | (1 << 9));
@@ -175,26 +210,139 @@ void updatePlayerScore(uint8_t score, uint8_t player)
 
 /***************************************************************************
  * flashWinnerScore()
- * @Parameter: uint8_t winner - Internal variable that determines what player leds should toggle.
+ * @Parameter: uint8_t winner - player whose score LEDs flash (1 or 2),
+ *             0 to stop a flash in progress
  * @return: None
- * Lights up LEDs for the score of the specified player (1 or 2).
+ * Starts flashing the score LEDs of the specified player. Returns at
+ * once; flashStep() runs the flash every FLASH_STEP_MS and
+ * flashWinnerBusy() tells when it is over. With no timer left in the
+ * pool there is no flash. A flash that is still running is cut short
+ * and its score LEDs put back first (flashEnd()).
  ***************************************************************************/
 void flashWinnerScore(uint8_t winner)
 {
-    for (int i = 0; i < 18; i++)  // Flash 9 times
-    {
-        if (winner == 1)
-        {
-            GPIOB->ODR ^= (1 << 8) | (1 << 9);  // Toggle PB8 & PB9
-            GPIOH->ODR ^= (1 << 0);             // Toggle PH0
-        }
-        else if (winner == 2)
-        {
-            GPIOH->ODR ^= (1 << 1);             // Toggle PH1
-            GPIOC->ODR ^= (1 << 2) | (1 << 3);   // Toggle PC2 & PC3
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    flashEnd();
+    coroInit(&flashCo);
+
+    if (winner == 1 || winner == 2) {
+        flashTimer = timerStart(FLASH_STEP_MS, flashStep,
+                                (void *)(uintptr_t)flashGen, TIMER_PERIODIC);
+        if (flashTimer)
+            flashWinner = winner;
+    }
+    __set_PRIMASK(primask);
+}
+
+/***************************************************************************
+ * flashWinnerBusy()
+ * @Parameter: None
+ * @return: 1 while a winner flash is running
+ ***************************************************************************/
+uint8_t flashWinnerBusy(void)
+{
+    return flashWinner != 0;
+}
+
+/***************************************************************************
+ * toggleScore()
+ * @Parameter: winner - 1 or 2
+ * @return: None
+ * Inverts that player's three score LEDs through BSRR, so a game step
+ * writing other pins of the same port in between is never undone.
+ ***************************************************************************/
+static void toggleScore(uint8_t winner)
+{
+    uint32_t odr;
+
+    if (winner == 1) {
+        odr = GPIOB->ODR;
+        GPIOB->BSRR = (~odr & ((1 << 8) | (1 << 9))) | ((odr & ((1 << 8) | (1 << 9))) << 16);
+        odr = GPIOH->ODR;
+        GPIOH->BSRR = (~odr & (1 << 0)) | ((odr & (1 << 0)) << 16);
+    }
+    else {
+        odr = GPIOH->ODR;
+        GPIOH->BSRR = (~odr & (1 << 1)) | ((odr & (1 << 1)) << 16);
+        odr = GPIOC->ODR;
+        GPIOC->BSRR = (~odr & ((1 << 2) | (1 << 3))) | ((odr & ((1 << 2) | (1 << 3))) << 16);
+    }
+}
+
+/***************************************************************************
+ * flashFlow()
+ * @Parameter: co - coroutine state
+ * @return: CORO_RUNNING / CORO_DONE
+ * With the brightness engine the LEDs pulse for the same time instead
+ * of toggling.
+ ***************************************************************************/
+static uint8_t flashFlow(Coro *co)
+{
+    static uint8_t first;
+
+    CORO_BEGIN(co);
+
+    if (brightnessActive) {
+        first = (flashWinner == 1) ? BRIGHT_P1_SCORE : BRIGHT_P2_SCORE;
+        for (uint8_t i = 0; i < 3; i++)
+            brightnessSetEffect(first + i, BRIGHT_PULSE);
+        CORO_AWAIT_TICKS(co, FLASH_TOGGLES);
+    }
+    else {
+        for (flashCount = 0; flashCount < FLASH_TOGGLES; flashCount++) {
+            toggleScore(flashWinner);
+            CORO_AWAIT_TICKS(co, 1);
         }
+    }
+
+    CORO_END(co);
+}
+
+/***************************************************************************
+ * flashStep()
+ * @Parameter: arg - generation of the flash the timer was started for
+ * @return: None
+ * Timer callback: one step of the winner flash. The timer goes back
+ * to the pool when the flash is over. A call for a flash that has
+ * been stopped or restarted since is ignored.
+ ***************************************************************************/
+static void flashStep(void *arg)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if ((uint8_t)(uintptr_t)arg == flashGen && flashWinner &&
+        flashFlow(&flashCo) == CORO_DONE)
+        flashEnd();
+    __set_PRIMASK(primask);
+}
+
+/***************************************************************************
+ * flashEnd()
+ * @Parameter: None
+ * @return: None
+ * Stops the flash, finished or cut short, and undoes it: the score
+ * LEDs go back to steady and are redrawn, which also rights them
+ * after an odd number of toggles. Called with PRIMASK set.
+ ***************************************************************************/
+static void flashEnd(void)
+{
+    uint8_t winner = flashWinner;
+
+    timerStop(flashTimer);
+    flashTimer = 0;
+    flashWinner = 0;
+    flashGen++;
+
+    if (winner == 1 || winner == 2) {
+        uint8_t first = (winner == 1) ? BRIGHT_P1_SCORE : BRIGHT_P2_SCORE;
 
-        for (volatile int d = 0; d < 50000; d++);  // Delay
+        if (brightnessActive)
+            for (uint8_t i = 0; i < 3; i++)
+                brightnessSetEffect(first + i, BRIGHT_STEADY);
+        updatePlayerScore(shownScore[winner - 1], winner);
     }
 }
 
@@ -203,11 +351,11 @@ void flashWinnerScore(uint8_t winner)
  * @param None
  * @return The current 8-bit LED pattern stored in ledPattern
  ************************************************************/
-uint8_t getCurrentLedPattern(void) {
+RAMFUNC uint8_t getCurrentLedPattern(void) {
     return ledPattern;
 }
 
-void setLedPattern(uint8_t pattern) {
+RAMFUNC void setLedPattern(uint8_t pattern) {
     ledPattern = pattern;
     update_LEDs_PC5to12();
 }
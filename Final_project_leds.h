@@ -13,6 +13,9 @@
 // LED modes (used in main to toggle between modes)
 #define PLAY_MODE 0
 #define FLASH_LED_MODE 1
+#define MULTIBALL_MODE 2
+#define NET_MODE 3
+#define DIAG_MODE 4
 
 // Global LED state variables (defined in led_setup.c)
 extern volatile uint8_t ledPattern;
@@ -34,7 +37,12 @@ void serve(void);
 
 // Score tracking and visual feedback
 void updatePlayerScore(uint8_t score, uint8_t player);
+
+// Winner flash: starts it and returns at once (winner 0 stops it).
+// A software timer steps it every FLASH_STEP_MS; 18 steps = 9 flashes.
+#define FLASH_STEP_MS 100
 void flashWinnerScore(uint8_t winner);
+uint8_t flashWinnerBusy(void);
 
 // Pattern accessors for FLASH_LED_MODE
 uint8_t getCurrentLedPattern(void);
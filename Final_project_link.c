@@ -0,0 +1,248 @@
+#include "link.h"
+
+/*=================================================================
+ * @file: link.c
+ * @brief: Board-to-board packet link
+ *
+ * Frames are length-prefixed and end with a CRC-16, so a bad or
+ * partial frame is dropped and the parser hunts for the next SOF.
+ * Nothing is retransmitted here: the netplay layer repeats every
+ * input until the other side acknowledges it.
+ *
+ * On the board the bytes go through USART1 with interrupt-driven
+ * ring buffers, so linkSend() and linkPoll() never wait on the
+ * UART. Build with LINK_HOST to use the host transport in
+ * tools/link_sim.c instead.
+ *===============================================================*/
+
+#define LINK_OVERHEAD 4           // SOF, length, CRC
+
+LinkStats linkStats;
+
+// Receive parser
+#define RX_HUNT 0
+#define RX_LEN  1
+#define RX_DATA 2
+#define RX_CRC1 3
+#define RX_CRC2 4
+
+static uint8_t rxState = RX_HUNT;
+static uint8_t rxLen;
+static uint8_t rxCount;
+static uint8_t rxBuf[LINK_MAX_PAYLOAD];
+static uint16_t rxCrc;
+
+/****************************************************************************
+ * linkCrc16()
+ * @parameter: data, len - bytes to check
+ * @return: CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ ****************************************************************************/
+uint16_t linkCrc16(const uint8_t *data, uint8_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+/****************************************************************************
+ * linkSend()
+ * @parameter: payload, len - up to LINK_MAX_PAYLOAD bytes
+ * @return: 1 if the frame was queued
+ ****************************************************************************/
+int linkSend(const uint8_t *payload, uint8_t len)
+{
+    uint8_t frame[LINK_MAX_PAYLOAD + LINK_OVERHEAD];
+    uint16_t crc;
+
+    if (len > LINK_MAX_PAYLOAD)
+        return 0;
+
+    crc = linkCrc16(payload, len);
+    frame[0] = LINK_SOF;
+    frame[1] = len;
+    for (uint8_t i = 0; i < len; i++)
+        frame[2 + i] = payload[i];
+    frame[2 + len] = (uint8_t)(crc >> 8);
+    frame[3 + len] = (uint8_t)crc;
+
+    if (!linkPortWrite(frame, len + LINK_OVERHEAD)) {
+        linkStats.txFull++;
+        return 0;
+    }
+    linkStats.framesOut++;
+    return 1;
+}
+
+/****************************************************************************
+ * linkPoll()
+ * @parameter: payload - receives up to LINK_MAX_PAYLOAD bytes
+ * @return: payload length of a complete, good frame, or 0
+ * Runs the parser over whatever bytes have arrived.
+ ****************************************************************************/
+uint8_t linkPoll(uint8_t *payload)
+{
+    uint8_t byte;
+
+    while (linkPortRead(&byte)) {
+        switch (rxState) {
+        case RX_HUNT:
+            if (byte == LINK_SOF)
+                rxState = RX_LEN;
+            break;
+
+        case RX_LEN:
+            if (byte == 0 || byte > LINK_MAX_PAYLOAD) {
+                rxState = (byte == LINK_SOF) ? RX_LEN : RX_HUNT;
+                break;
+            }
+            rxLen = byte;
+            rxCount = 0;
+            rxState = RX_DATA;
+            break;
+
+        case RX_DATA:
+            rxBuf[rxCount++] = byte;
+            if (rxCount == rxLen)
+                rxState = RX_CRC1;
+            break;
+
+        case RX_CRC1:
+            rxCrc = (uint16_t)byte << 8;
+            rxState = RX_CRC2;
+            break;
+
+        case RX_CRC2:
+            rxCrc |= byte;
+            rxState = RX_HUNT;
+            if (rxCrc != linkCrc16(rxBuf, rxLen)) {
+                linkStats.crcErrors++;
+                break;
+            }
+            for (uint8_t i = 0; i < rxLen; i++)
+                payload[i] = rxBuf[i];
+            linkStats.framesIn++;
+            return rxLen;
+        }
+    }
+    return 0;
+}
+
+#ifndef LINK_HOST
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*-----------------------------------------------------------------
+ * USART1 transport: PA9 TX, PA10 RX (AF7), 8N1 at LINK_BAUD.
+ * RXNE and TXE interrupts move bytes to/from power-of-two rings.
+ *---------------------------------------------------------------*/
+
+#define LINK_UART_CLK 4000000     // USART1 kernel clock (PCLK2 = MSI)
+#define LINK_RING     64          // power of two
+
+static volatile uint8_t txRing[LINK_RING];
+static volatile uint8_t txHead, txTail;
+static volatile uint8_t rxRing[LINK_RING];
+static volatile uint8_t rxHead, rxTail;
+
+/****************************************************************************
+ * init_Link()
+ * @parameter: None
+ * @return: None
+ ****************************************************************************/
+void init_Link(void)
+{
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN;
+    RCC->APB2ENR |= RCC_APB2ENR_USART1EN;
+
+    // --- PA9, PA10: alternate function 7, PA10 pulled up while idle ---
+    GPIOA->AFR[1] = (GPIOA->AFR[1] & ~((0xFUL << 4) | (0xFUL << 8))) |
+                    (7UL << 4) | (7UL << 8);
+    GPIOA->PUPDR = (GPIOA->PUPDR & ~(3UL << (10 * 2))) | (1UL << (10 * 2));
+    GPIOA->MODER = (GPIOA->MODER & ~((3UL << (9 * 2)) | (3UL << (10 * 2)))) |
+                   (2UL << (9 * 2)) | (2UL << (10 * 2));
+
+    USART1->CR1 = 0;
+    USART1->BRR = (LINK_UART_CLK + LINK_BAUD / 2) / LINK_BAUD;
+    USART1->CR1 = USART_CR1_TE | USART_CR1_RE | USART_CR1_RXNEIE | USART_CR1_UE;
+
+    NVIC_EnableIRQ(USART1_IRQn);
+}
+
+/****************************************************************************
+ * USART1_IRQHandler()
+ * @parameter: None
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void USART1_IRQHandler(void)
+{
+    uint32_t isr = USART1->ISR;
+
+    if (isr & USART_ISR_ORE) {
+        USART1->ICR = USART_ICR_ORECF;
+        linkStats.rxOverruns++;
+    }
+
+    if (isr & USART_ISR_RXNE) {
+        uint8_t byte = (uint8_t)USART1->RDR;
+        uint8_t next = (rxHead + 1) & (LINK_RING - 1);
+
+        if (next != rxTail) {
+            rxRing[rxHead] = byte;
+            rxHead = next;
+        }
+        else {
+            linkStats.rxOverruns++;
+        }
+    }
+
+    if ((isr & USART_ISR_TXE) && (USART1->CR1 & USART_CR1_TXEIE)) {
+        if (txTail != txHead) {
+            USART1->TDR = txRing[txTail];
+            txTail = (txTail + 1) & (LINK_RING - 1);
+        }
+        else {
+            USART1->CR1 &= ~USART_CR1_TXEIE;      // queue empty
+        }
+    }
+}
+
+/****************************************************************************
+ * linkPortWrite()
+ * @parameter: data, len - one whole frame
+ * @return: 1 if queued; the frame is queued whole or not at all
+ ****************************************************************************/
+int linkPortWrite(const uint8_t *data, uint8_t len)
+{
+    uint8_t free = (uint8_t)((txTail - txHead - 1) & (LINK_RING - 1));
+
+    if (len > free)
+        return 0;
+
+    for (uint8_t i = 0; i < len; i++) {
+        txRing[txHead] = data[i];
+        txHead = (txHead + 1) & (LINK_RING - 1);
+    }
+    USART1->CR1 |= USART_CR1_TXEIE;
+    return 1;
+}
+
+/****************************************************************************
+ * linkPortRead()
+ * @parameter: byte - receives the next byte
+ * @return: 1 if there was one
+ ****************************************************************************/
+int linkPortRead(uint8_t *byte)
+{
+    if (rxTail == rxHead)
+        return 0;
+
+    *byte = rxRing[rxTail];
+    rxTail = (rxTail + 1) & (LINK_RING - 1);
+    return 1;
+}
+#endif
@@ -0,0 +1,45 @@
+#ifndef LINK_H
+#define LINK_H
+
+/*************************************************
+ * @file: link.h
+ *
+ * Header file for link.c
+ * Framed, CRC-checked packets between two boards over USART1
+ * (PA9 TX, PA10 RX, crossed over, common ground).
+ *
+ * Frame: LINK_SOF, length, payload, CRC-16/CCITT (high byte first)
+ *************************************************/
+
+#include <stdint.h>
+
+#define LINK_SOF         0x7E
+#define LINK_MAX_PAYLOAD 16
+#define LINK_BAUD        115200
+
+typedef struct {
+    uint32_t framesOut;
+    uint32_t framesIn;
+    uint32_t crcErrors;
+    uint32_t txFull;       // frames dropped because the TX queue was full
+    uint32_t rxOverruns;   // bytes lost before the parser saw them
+} LinkStats;
+
+extern LinkStats linkStats;
+
+void init_Link(void);
+
+// Queues one frame. Returns 1 if queued, 0 if the TX queue is full.
+int linkSend(const uint8_t *payload, uint8_t len);
+
+// Returns the payload length of the next good frame (0 = none yet)
+uint8_t linkPoll(uint8_t *payload);
+
+// Byte transport. USART1 on the board; tools/link_sim.c on the host.
+// linkPortWrite() takes a whole frame or nothing (returns 0).
+int linkPortWrite(const uint8_t *data, uint8_t len);
+int linkPortRead(uint8_t *byte);
+
+uint16_t linkCrc16(const uint8_t *data, uint8_t len);
+
+#endif
@@ -0,0 +1,97 @@
+#include "load.h"
+#include "sched.h"
+#include "irq.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: load.c
+ * @brief: CPU load meter and tick overrun report
+ *
+ * The scheduler adds up the TIM5 counts the core spends in WFI
+ * (schedIdle). Everything else is busy: tasks, interrupts and the
+ * game step alike. Each loadUpdate() closes a window, so the load
+ * is (window - idle) / window. TIM5 is used rather than DWT because
+ * the cycle counter stops while the core sleeps.
+ *
+ * The report is written by the window task and read from the game
+ * step (PendSV) or the debugger, so it is copied in and out with
+ * PRIMASK set.
+ *===============================================================*/
+
+static LoadReport report;
+static uint32_t windowStart;
+static uint32_t idleStart;
+static uint32_t lastFaults;
+static uint8_t started;
+
+/****************************************************************************
+ * tickFaults()
+ * @parameter: None
+ * @return: late + missed + overrun counts of both tick slots
+ ****************************************************************************/
+static uint32_t tickFaults(void)
+{
+    return irqStats[IRQ_STAT_SYSTICK].late + irqStats[IRQ_STAT_SYSTICK].missed +
+           irqStats[IRQ_STAT_SYSTICK].overruns +
+           irqStats[IRQ_STAT_INPUT].late + irqStats[IRQ_STAT_INPUT].missed;
+}
+
+/****************************************************************************
+ * loadUpdate()
+ * @parameter: None
+ * @return: None
+ * The first call only starts the first window.
+ ****************************************************************************/
+void loadUpdate(void)
+{
+    LoadReport next;
+    uint32_t now = TIM5->CNT;
+    uint32_t idle = schedIdle;
+    uint32_t window = now - windowStart;
+    uint32_t slept = idle - idleStart;
+    uint32_t faults = tickFaults();
+
+    windowStart = now;
+    idleStart = idle;
+
+    if (!started) {
+        started = 1;
+        lastFaults = faults;
+        return;
+    }
+
+    next = report;
+    next.windows++;
+    next.windowCounts = window;
+    next.busyCounts = (slept < window) ? window - slept : 0;
+    next.loadPermille = window ? (uint16_t)(((uint64_t)next.busyCounts * 1000) / window) : 0;
+    if (next.loadPermille > next.peakPermille)
+        next.peakPermille = next.loadPermille;
+
+    next.tickLate = irqStats[IRQ_STAT_SYSTICK].late;
+    next.tickMissed = irqStats[IRQ_STAT_SYSTICK].missed;
+    next.tickOverruns = irqStats[IRQ_STAT_SYSTICK].overruns;
+    next.inputLate = irqStats[IRQ_STAT_INPUT].late;
+    next.inputMissed = irqStats[IRQ_STAT_INPUT].missed;
+    next.windowFaults = faults - lastFaults;
+    lastFaults = faults;
+
+    __disable_irq();
+    report = next;
+    __enable_irq();
+}
+
+/****************************************************************************
+ * loadRead()
+ * @parameter: out - filled with the latest report
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void loadRead(LoadReport *out)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *out = report;
+    __set_PRIMASK(primask);
+}
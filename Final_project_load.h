@@ -0,0 +1,37 @@
+#ifndef LOAD_H
+#define LOAD_H
+
+/*************************************************
+ * @file: load.h
+ *
+ * Header file for load.c
+ * Whole-system CPU load: the share of each window the core spent
+ * outside WFI, plus the tick health counters of the periodic
+ * interrupts (irq.h), gathered into one report that any context
+ * can copy with loadRead().
+ *************************************************/
+
+#include <stdint.h>
+
+typedef struct {
+    uint16_t loadPermille;   // busy share of the last window
+    uint16_t peakPermille;   // busiest window since boot
+    uint32_t windows;
+    uint32_t windowCounts;   // length of the last window, TIM5 counts
+    uint32_t busyCounts;     // not in WFI during it
+    // SysTick (game tick) and input sampling (sampler.c / TIM2), totals
+    uint32_t tickLate;
+    uint32_t tickMissed;
+    uint32_t tickOverruns;   // game step unfinished at the next tick
+    uint32_t inputLate;
+    uint32_t inputMissed;
+    uint32_t windowFaults;   // all of the above, last window only
+} LoadReport;
+
+// Closes a window and starts the next; call every LOAD_WINDOW_MS
+void loadUpdate(void);
+
+// Consistent copy of the latest report (safe from any context)
+void loadRead(LoadReport *report);
+
+#endif
@@ -1,6 +1,7 @@
 #include "stm32l476xx.h"
 #include "led_setup.h"
 #include "buttons.h"
+#include "swtimer.h"
 
 /**
  ================================================================
@@ -46,12 +47,14 @@ static uint8_t player1Score = 0;
 static uint8_t player2Score = 0;
 uint32_t currentSpeed = INITIAL_SPEED;
 static int hitWaitTicks = 0;
+static uint8_t winShown = 0;     // winner flash started for this STATE_WIN
 uint32_t msTimer = 0;
 
 // === Function Prototypes ===
 void configureSysTick(uint32_t reloadValue);
 void SysTick_Handler(void);
 void handleFlashLedMode(void);
+static void startTimeBase(void);
 
 /**
  * @brief Main entry point
@@ -61,6 +64,7 @@ int main(void)
 {
     init_Buttons();
     init_LEDs_PC5to12();
+    startTimeBase();                 // TIM5 for the winner flash timer
     configureSysTick(currentSpeed);  // Set initial speed
     serve();
 
@@ -114,6 +118,9 @@ int main(void)
 
         prevUserBtn = currUserBtn;
 
+        // Steps the winner flash (software timer callbacks)
+        timerService();
+
         // Run FLASH mode logic if active
         if (led_mode == FLASH_LED_MODE)
         {
@@ -122,6 +129,28 @@ int main(void)
         }
     }
 }
+/**
+ * @brief Starts TIM5 free-running at 4 MHz, the time base of the
+ * software timers (swtimer.c) that step the winner flash.
+ */
+static void startTimeBase(void)
+{
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM5EN;
+    TIM5->PSC = 0;
+    TIM5->ARR = 0xFFFFFFFF;
+    TIM5->EGR = TIM_EGR_UG;
+    TIM5->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * @brief Software timers are due at TIM5 count `due`. main() calls
+ * timerService() on every pass of its loop, so there is nothing to book.
+ */
+void timerWake(uint32_t due)
+{
+    (void)due;
+}
+
 /**
  * @brief Configures the SysTick timer for the game speed.
  * @param reloadValue The reload value determining the speed in ticks.
@@ -146,7 +175,7 @@ void SysTick_Handler(void)
     // === Debounce Buttons ===
     for (int i = 0; i < NUM_BUTTONS; i++) {
         buttons[i].filter <<= 1U;
-        if (buttons[i].port->IDR & (1U << buttons[i].pin))
+        if (BUTTON_PORT->IDR & (1U << buttons[i].pin))
             buttons[i].filter |= 1U;
 
         buttons[i].filter &= 0xFF;
@@ -253,12 +282,21 @@ void SysTick_Handler(void)
                break;
 
            case STATE_WIN:
-               if (player1Score >= 3) {
-                   flashWinnerScore(1);
-               } else if (player2Score >= 3) {
-                   flashWinnerScore(2);
+               // flashWinnerScore() only starts the flash; main() steps
+               // it. The game resets once it is over.
+               if (!winShown) {
+                   if (player1Score >= 3) {
+                       flashWinnerScore(1);
+                   } else if (player2Score >= 3) {
+                       flashWinnerScore(2);
+                   }
+                   winShown = 1;
+                   break;
                }
+               if (flashWinnerBusy())
+                   break;
 
+               winShown = 0;
                player1Score = 0;
                player2Score = 0;
                updatePlayerScore(0, 1);
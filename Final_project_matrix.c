@@ -0,0 +1,143 @@
+#include "matrix.h"
+#ifndef MATRIX_HOST
+#include "stm32l476xx.h"
+#endif
+#include "memmap.h"
+
+/*=================================================================
+ * @file: matrix.c
+ * @brief: MAX7219 8x8 matrix backend over SPI2 + DMA
+ *
+ * Wiring: PB13 = CLK, PB15 = DIN, PB12 = LOAD (all AF5, SPI2).
+ *
+ * Every MAX7219 command is one 16-bit word (register << 8 | data),
+ * latched on the rising edge of LOAD. SPI2 runs in 16-bit frames
+ * with hardware NSS in pulse mode (NSSP), so LOAD goes high between
+ * words and each word latches by itself. DMA1 channel 5 streams the
+ * whole command list into SPI2->DR in circular mode: the setup
+ * registers, then one word per row. The matrix is rewritten
+ * continuously at a rate set by the SPI clock, with no interrupts.
+ *
+ * Sending the setup words on every pass also brings the chip back
+ * if it browns out or is plugged in late.
+ *
+ * Drawing only changes the low byte of a row word. Those are
+ * halfword stores, so the DMA never sees a torn row.
+ *
+ * Build with MATRIX_HOST to leave out the SPI2/DMA setup;
+ * tools/matrix_host.c plays the stream into a MAX7219 model instead.
+ *===============================================================*/
+
+#define MAX7219_DECODE    0x09
+#define MAX7219_INTENSITY 0x0A
+#define MAX7219_SCANLIMIT 0x0B
+#define MAX7219_SHUTDOWN  0x0C
+#define MAX7219_TEST      0x0F
+#define MAX7219_DIGIT0    0x01
+
+#define MATRIX_SETUP_WORDS 5
+#define MATRIX_WORDS (MATRIX_SETUP_WORDS + MATRIX_ROWS)
+
+// SPI clock = 4 MHz / 64 = 62.5 kHz -> 62500 / (16 * 13) = ~300 refreshes/s
+#define MATRIX_SPI_BR 5
+
+static volatile uint16_t txWords[MATRIX_WORDS] = {
+    (MAX7219_DECODE << 8)    | 0x00,   // raw segments, no BCD decode
+    (MAX7219_INTENSITY << 8) | MATRIX_INTENSITY,
+    (MAX7219_SCANLIMIT << 8) | 0x07,   // scan all 8 digits (rows)
+    (MAX7219_SHUTDOWN << 8)  | 0x01,   // normal operation
+    (MAX7219_TEST << 8)      | 0x00,
+    ((MAX7219_DIGIT0 + 0) << 8), ((MAX7219_DIGIT0 + 1) << 8),
+    ((MAX7219_DIGIT0 + 2) << 8), ((MAX7219_DIGIT0 + 3) << 8),
+    ((MAX7219_DIGIT0 + 4) << 8), ((MAX7219_DIGIT0 + 5) << 8),
+    ((MAX7219_DIGIT0 + 6) << 8), ((MAX7219_DIGIT0 + 7) << 8)
+};
+
+#ifndef MATRIX_HOST
+/****************************************************************************
+ * init_Matrix()
+ * @parameter: None
+ * @return: None
+ * Configures PB12/13/15 for SPI2, SPI2 as a 16-bit master with pulsed
+ * hardware NSS, and DMA1 channel 5 as a circular feed of txWords[].
+ ****************************************************************************/
+void init_Matrix(void)
+{
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOBEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR1 |= RCC_APB1ENR1_SPI2EN;
+
+    // --- PB12 (NSS/LOAD), PB13 (SCK), PB15 (MOSI): AF5 ---
+    for (int pin = 12; pin <= 15; pin++) {
+        if (pin == 14) continue;               // MISO not used
+        GPIOB->MODER   &= ~(3UL << (pin * 2));
+        GPIOB->MODER   |=  (2UL << (pin * 2));
+        GPIOB->OTYPER  &= ~(1UL << pin);
+        GPIOB->OSPEEDR &= ~(3UL << (pin * 2));
+        GPIOB->PUPDR   &= ~(3UL << (pin * 2));
+        GPIOB->AFR[1]  &= ~(0xFUL << ((pin - 8) * 4));
+        GPIOB->AFR[1]  |=  (5UL << ((pin - 8) * 4));
+    }
+
+    // --- SPI2: master, mode 0, 16-bit, NSS pulse between words ---
+    SPI2->CR1 = 0;
+    SPI2->CR1 = SPI_CR1_MSTR | (MATRIX_SPI_BR << SPI_CR1_BR_Pos);
+    SPI2->CR2 = (15UL << SPI_CR2_DS_Pos) | SPI_CR2_SSOE | SPI_CR2_NSSP |
+                SPI_CR2_TXDMAEN;
+
+    // --- DMA1 channel 5 (request 1 = SPI2_TX): txWords[] -> SPI2->DR ---
+    DMA1_CSELR->CSELR = (DMA1_CSELR->CSELR & ~(0xFUL << DMA_CSELR_C5S_Pos)) |
+                        (1UL << DMA_CSELR_C5S_Pos);
+    DMA1_Channel5->CCR = 0;
+    DMA1_Channel5->CPAR = (uint32_t)&SPI2->DR;
+    DMA1_Channel5->CMAR = (uint32_t)txWords;
+    DMA1_Channel5->CNDTR = MATRIX_WORDS;
+    DMA1_Channel5->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_CIRC |
+                         DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 | DMA_CCR_EN;
+
+    SPI2->CR1 |= SPI_CR1_SPE;                  // TXE starts the DMA stream
+}
+#endif
+
+/****************************************************************************
+ * matrixStream()
+ * @parameter: count - set to the number of words
+ * @return: the command list DMA1 channel 5 sends, one word per SPI frame
+ ****************************************************************************/
+const volatile uint16_t *matrixStream(uint8_t *count)
+{
+    *count = MATRIX_WORDS;
+    return txWords;
+}
+
+/****************************************************************************
+ * matrixSetRow()
+ * @parameter: row - 0..7, columns - one bit per LED
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void matrixSetRow(uint8_t row, uint8_t columns)
+{
+    txWords[MATRIX_SETUP_WORDS + row] = (uint16_t)(((MAX7219_DIGIT0 + row) << 8) | columns);
+}
+
+RAMFUNC uint8_t matrixGetRow(uint8_t row)
+{
+    return (uint8_t)txWords[MATRIX_SETUP_WORDS + row];
+}
+
+/****************************************************************************
+ * matrixSetFrame()
+ * @parameter: rows - 8 row bytes, top row first
+ * @return: None
+ ****************************************************************************/
+void matrixSetFrame(const uint8_t rows[MATRIX_ROWS])
+{
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++)
+        matrixSetRow(r, rows[r]);
+}
+
+void matrixClear(void)
+{
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++)
+        matrixSetRow(r, 0);
+}
@@ -0,0 +1,32 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+/*************************************************
+ * @file: matrix.h
+ *
+ * Header file for matrix.c
+ * 8x8 LED matrix (MAX7219) on SPI2, refreshed from a frame buffer
+ * by DMA with no CPU time per refresh.
+ *************************************************/
+
+#include <stdint.h>
+
+#define MATRIX_ROWS       8
+#define MATRIX_COURT_ROW  3   // row that mirrors the 1D playfield
+#define MATRIX_INTENSITY  0x08 // 0x0 (dim) .. 0xF (bright)
+
+void init_Matrix(void);
+
+// Bit n of a row byte is column n (same order as ledPattern)
+void matrixSetRow(uint8_t row, uint8_t columns);
+uint8_t matrixGetRow(uint8_t row);
+
+// Replaces all 8 rows; rows[0] is the top row
+void matrixSetFrame(const uint8_t rows[MATRIX_ROWS]);
+void matrixClear(void);
+
+// The MAX7219 words streamed to SPI2 on every pass, setup words first
+// (tools/matrix_host.c)
+const volatile uint16_t *matrixStream(uint8_t *count);
+
+#endif
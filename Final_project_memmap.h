@@ -0,0 +1,29 @@
+#ifndef MEMMAP_H
+#define MEMMAP_H
+
+/*************************************************
+ * @file: memmap.h
+ *
+ * Placement of hot code and data.
+ * RAMFUNC code is copied to SRAM1 with .data at reset and runs
+ * without flash wait states. SRAM2_DATA variables live in SRAM2
+ * (0x1000_0000), which is reached over its own bus, so ISR state
+ * does not compete with the stack and .bss in SRAM1.
+ * NOINIT variables are not zeroed at reset: only for buffers that
+ * are always written before they are read.
+ * RETAINED variables are in SRAM2 and neither loaded nor zeroed at
+ * reset, so they keep their value through Standby (standby.c).
+ *************************************************/
+
+#include <stdint.h>
+
+#define RAMFUNC    __attribute__((section(".RamFunc"), noinline))
+#define SRAM2_DATA __attribute__((section(".sram2")))
+#define NOINIT     __attribute__((section(".noinit")))
+#define RETAINED   __attribute__((section(".retained")))
+
+// Sets flash wait states for hclk (voltage range 1) and turns on
+// prefetch and the instruction/data caches (ART accelerator)
+void configureFlashAccelerator(uint32_t hclk);
+
+#endif
@@ -0,0 +1,106 @@
+#include "multiball.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: multiball.c
+ * @brief: Multi-ball court with SIMD-within-a-register updates
+ *
+ * All balls moving the same way advance with one 64-bit shift. The
+ * column mask is cleared first so a ball never carries into the
+ * next lane. Paddle hits and passes are ANDs with the paddle column
+ * of all 8 lanes, and the event counts are a SWAR popcount. A step
+ * is the same short sequence of mask operations for 1 ball or 64.
+ *
+ * A ball in a paddle column when the step runs is either returned
+ * (the paddle is swinging: it turns round in place and leaves on the
+ * next step, like STATE_*_HIT in the 1D game) or passes the player
+ * and leaves the court.
+ *===============================================================*/
+
+#define COL_P1 0x0101010101010101ULL    // column 0 of every lane
+#define COL_P2 0x8080808080808080ULL    // column 7 of every lane
+
+/****************************************************************************
+ * popcount64()
+ * @parameter: x - mask
+ * @return: number of set bits (SWAR: pairs, nibbles, bytes, then sum)
+ ****************************************************************************/
+static RAMFUNC uint8_t popcount64(uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint8_t)((x * 0x0101010101010101ULL) >> 56);
+}
+
+/****************************************************************************
+ * multiballClear()
+ * @parameter: mb - court
+ * @return: None
+ ****************************************************************************/
+void multiballClear(Multiball *mb)
+{
+    mb->toP2 = 0;
+    mb->toP1 = 0;
+}
+
+/****************************************************************************
+ * multiballLaunch()
+ * @parameter: mb - court, player - 1 or 2, lane - 0..7
+ * @return: None
+ ****************************************************************************/
+void multiballLaunch(Multiball *mb, uint8_t player, uint8_t lane)
+{
+    lane &= MULTIBALL_LANES - 1;
+
+    if (player == 1)
+        mb->toP2 |= 0x01ULL << (lane * 8);
+    else
+        mb->toP1 |= 0x80ULL << (lane * 8);
+}
+
+/****************************************************************************
+ * multiballStep()
+ * @parameter: mb - court, swing1/swing2 - paddles swinging,
+ *             events - filled with this step's returns and passes
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void multiballStep(Multiball *mb, uint8_t swing1, uint8_t swing2,
+                           MultiballEvents *events)
+{
+    uint64_t atP1 = mb->toP1 & COL_P1;
+    uint64_t atP2 = mb->toP2 & COL_P2;
+
+    // Branch-free: all ones when swinging, zero otherwise
+    uint64_t hitP1 = atP1 & (0ULL - (uint64_t)(swing1 != 0));
+    uint64_t hitP2 = atP2 & (0ULL - (uint64_t)(swing2 != 0));
+
+    events->returned[0] = popcount64(hitP1);
+    events->returned[1] = popcount64(hitP2);
+    events->passed[0]   = popcount64(atP1 ^ hitP1);
+    events->passed[1]   = popcount64(atP2 ^ hitP2);
+
+    // Everything else moves one column; returned balls turn round in place
+    mb->toP2 = ((mb->toP2 & ~COL_P2) << 1) | hitP1;
+    mb->toP1 = ((mb->toP1 & ~COL_P1) >> 1) | hitP2;
+}
+
+/****************************************************************************
+ * multiballOccupied()
+ * @parameter: mb - court
+ * @return: mask of all cells holding a ball (for drawing)
+ ****************************************************************************/
+RAMFUNC uint64_t multiballOccupied(const Multiball *mb)
+{
+    return mb->toP2 | mb->toP1;
+}
+
+/****************************************************************************
+ * multiballCount()
+ * @parameter: mb - court
+ * @return: balls in play (two balls crossing in one cell count twice)
+ ****************************************************************************/
+uint8_t multiballCount(const Multiball *mb)
+{
+    return popcount64(mb->toP2) + popcount64(mb->toP1);
+}
@@ -0,0 +1,41 @@
+#ifndef MULTIBALL_H
+#define MULTIBALL_H
+
+/*************************************************
+ * @file: multiball.h
+ *
+ * Header file for multiball.c
+ * Any number of balls on an 8x8 court, kept as two 64-bit masks.
+ * Bit (lane * 8 + column) is a ball in that lane and column; each
+ * lane is one 1D court, shown as one row of the LED matrix.
+ * Column 0 is player 1's paddle, column 7 player 2's (the same
+ * order as ledPattern).
+ *************************************************/
+
+#include <stdint.h>
+
+#define MULTIBALL_LANES 8
+
+typedef struct {
+    uint64_t toP2;     // balls moving toward column 7 (shiftLeft direction)
+    uint64_t toP1;     // balls moving toward column 0 (shiftRight direction)
+} Multiball;
+
+// What one step did, per player
+typedef struct {
+    uint8_t returned[2];   // balls the player sent back ([0] = player 1)
+    uint8_t passed[2];     // balls that got past the player
+} MultiballEvents;
+
+void multiballClear(Multiball *mb);
+
+// Puts a ball on a player's paddle in the given lane, moving away from it
+void multiballLaunch(Multiball *mb, uint8_t player, uint8_t lane);
+
+// One tick for every ball: swing1/swing2 = that paddle is swinging
+void multiballStep(Multiball *mb, uint8_t swing1, uint8_t swing2, MultiballEvents *events);
+
+uint64_t multiballOccupied(const Multiball *mb);
+uint8_t multiballCount(const Multiball *mb);
+
+#endif
@@ -0,0 +1,425 @@
+#include "netplay.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: netplay.c
+ * @brief: Lockstep two-board Pong with rollback
+ *
+ * Both boards run the same netGameStep() on the same inputs, so they
+ * stay in step without ever sending game state. A board does not
+ * wait for the other one's input: it runs the tick with a guess
+ * (the last input it got) and sends its own input. When the real
+ * input arrives and the guess was wrong, the game goes back to the
+ * saved state before that tick and runs the ticks again. The state
+ * is 7 bytes, so a rollback is a copy and a few steps.
+ *
+ * A press therefore counts on the tick it happened on the board it
+ * was made on, on both boards, whatever the link delay. Hit and
+ * miss are judged the same way as in a one-board game. Only the
+ * picture on the other board can be corrected a tick late.
+ *
+ * Packets carry every input the other board has not acknowledged,
+ * so lost or corrupted frames need no retransmit timer. They also
+ * carry a hash of the last state both boards agree on; a mismatch
+ * counts as a desync.
+ *
+ * Tick numbers are 16 bits and wrap; they are compared as signed
+ * differences.
+ *
+ * Packets also carry the sender's session id and the id it has for
+ * us. A board sends its id with 0 for ours until it hears from us,
+ * and runs no ticks until a packet comes back with its own id, so
+ * both boards start at tick 0 together. A new id with 0 for ours
+ * means the peer started a new session (reset, or NET_MODE left and
+ * entered again): we start over too, under a new id, so packets
+ * still in flight from either old session are told apart and
+ * dropped.
+ *
+ * Wins are taken from the settled state only (netConfirmed()), so
+ * a win that a rollback undoes is never shown, one that only shows
+ * up in a rollback is not missed, and each is reported once.
+ *===============================================================*/
+
+#define SLOT(n) ((n) & (NET_WINDOW - 1))
+
+// Signed distance a - b for wrapping tick numbers
+#define TICK_DIFF(a, b) ((int16_t)(uint16_t)((a) - (b)))
+
+/****************************************************************************
+ * netGameReset()
+ * @parameter: g - game
+ * @return: None
+ * Player 1 serves first, like PLAY_MODE.
+ ****************************************************************************/
+void netGameReset(NetGame *g)
+{
+    g->pos = 0;
+    g->dir = 0;
+    g->server = 0;
+    g->score[0] = 0;
+    g->score[1] = 0;
+    g->winner = 0;
+}
+
+/****************************************************************************
+ * netPoint()
+ * @parameter: g - game, scorer - 0 or 1
+ * @return: None
+ * The player who missed serves next. A win starts a new game.
+ ****************************************************************************/
+static RAMFUNC void netPoint(NetGame *g, uint8_t scorer)
+{
+    g->score[scorer]++;
+    g->server = scorer ^ 1;
+
+    if (g->score[scorer] >= NET_WIN_SCORE) {
+        g->winner = scorer + 1;
+        g->score[0] = 0;
+        g->score[1] = 0;
+        g->server = 0;
+    }
+
+    g->dir = 0;
+    g->pos = g->server ? NET_CELLS - 1 : 0;
+}
+
+/****************************************************************************
+ * netGameStep()
+ * @parameter: g - game, inputs - NET_IN_P1 / NET_IN_P2 pressing
+ * @return: None
+ * The PLAY_MODE rules on a 16-cell court: a press on the paddle cell
+ * returns the ball, a press one cell early is a miss, a press
+ * anywhere else holds the ball for that tick.
+ ****************************************************************************/
+RAMFUNC void netGameStep(NetGame *g, uint8_t inputs)
+{
+    g->winner = 0;
+
+    if (g->dir == 0) {
+        // Waiting for the server
+        g->pos = g->server ? NET_CELLS - 1 : 0;
+        if (inputs & (g->server ? NET_IN_P2 : NET_IN_P1))
+            g->dir = g->server ? -1 : 1;
+        return;
+    }
+
+    if (g->dir > 0) {
+        if (inputs & NET_IN_P2) {
+            if (g->pos == NET_CELLS - 1)
+                g->dir = -1;                 // return
+            else if (g->pos == NET_CELLS - 2)
+                netPoint(g, 0);              // pressed early
+        }
+        else if (g->pos == NET_CELLS - 1) {
+            netPoint(g, 0);                  // passed player 2
+        }
+        else {
+            g->pos++;
+        }
+    }
+    else {
+        if (inputs & NET_IN_P1) {
+            if (g->pos == 0)
+                g->dir = 1;
+            else if (g->pos == 1)
+                netPoint(g, 1);
+        }
+        else if (g->pos == 0) {
+            netPoint(g, 1);
+        }
+        else {
+            g->pos--;
+        }
+    }
+}
+
+/****************************************************************************
+ * netGameHash()
+ * @parameter: g - game
+ * @return: 8-bit FNV-1a of the fields (not the struct bytes)
+ ****************************************************************************/
+uint8_t netGameHash(const NetGame *g)
+{
+    const uint8_t fields[] = {
+        (uint8_t)g->pos, (uint8_t)g->dir, g->server,
+        g->score[0], g->score[1], g->winner
+    };
+    uint32_t h = 2166136261u;
+
+    for (uint32_t i = 0; i < sizeof(fields); i++)
+        h = (h ^ fields[i]) * 16777619u;
+    return (uint8_t)(h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24));
+}
+
+/****************************************************************************
+ * netInputs()
+ * @parameter: s - session, n - tick
+ * @return: both players' inputs for tick n
+ ****************************************************************************/
+static RAMFUNC uint8_t netInputs(const NetSession *s, uint16_t n)
+{
+    return (uint8_t)((s->local[SLOT(n)] << s->localPlayer) |
+                     (s->remote[SLOT(n)] << (s->localPlayer ^ 1)));
+}
+
+/****************************************************************************
+ * netConfirmed()
+ * @parameter: s - session
+ * @return: newest tick whose state both boards have settled
+ ****************************************************************************/
+static uint16_t netConfirmed(const NetSession *s)
+{
+    return TICK_DIFF(s->remoteTick, s->tick) < 0 ? s->remoteTick : s->tick;
+}
+
+/****************************************************************************
+ * netStateBefore()
+ * @parameter: s - session, n - tick in the window
+ * @return: the state before tick n
+ ****************************************************************************/
+static const NetGame *netStateBefore(const NetSession *s, uint16_t n)
+{
+    return (n == s->tick) ? &s->game : &s->history[SLOT(n)];
+}
+
+/****************************************************************************
+ * netSessionInit()
+ * @parameter: s - session, localPlayer - 0 = player 1, 1 = player 2,
+ *             id - this board's session id
+ * @return: None
+ ****************************************************************************/
+void netSessionInit(NetSession *s, uint8_t localPlayer, uint16_t id)
+{
+    uint8_t *p = (uint8_t *)s;
+
+    for (uint32_t i = 0; i < sizeof(*s); i++)
+        p[i] = 0;
+
+    s->localPlayer = localPlayer & 1;
+    s->id = id ? id : 1;
+    netGameReset(&s->game);
+}
+
+/****************************************************************************
+ * netSessionRestart()
+ * @parameter: s - session
+ * @return: None
+ * Starts over at tick 0 under the next id, keeping the counters.
+ ****************************************************************************/
+static void netSessionRestart(NetSession *s)
+{
+    NetStats stats = s->stats;
+    uint16_t id = (uint16_t)(s->id * 25173u + 13849u);   // full-period LCG
+
+    netSessionInit(s, s->localPlayer, id);
+    s->stats = stats;
+    s->stats.resyncs++;
+}
+
+/****************************************************************************
+ * netLatchWin()
+ * @parameter: s - session
+ * @return: None
+ * Looks for a win in the ticks that have settled since the last call.
+ ****************************************************************************/
+static RAMFUNC void netLatchWin(NetSession *s)
+{
+    uint16_t settled = netConfirmed(s);
+
+    for (; s->winSeen != settled; s->winSeen++) {
+        const NetGame *after = netStateBefore(s, (uint16_t)(s->winSeen + 1));
+
+        if (after->winner) {
+            s->winner = after->winner;
+            s->winTick = s->winSeen;
+        }
+    }
+}
+
+/****************************************************************************
+ * netSessionSettled()
+ * @parameter: s - session
+ * @return: the state before the first tick still on a guess
+ ****************************************************************************/
+const NetGame *netSessionSettled(const NetSession *s)
+{
+    return netStateBefore(s, netConfirmed(s));
+}
+
+/****************************************************************************
+ * netSessionTakeWin()
+ * @parameter: s - session
+ * @return: the winner of a settled win not taken yet, else 0
+ ****************************************************************************/
+uint8_t netSessionTakeWin(NetSession *s)
+{
+    uint8_t winner = s->winner;
+
+    s->winner = 0;
+    return winner;
+}
+
+/****************************************************************************
+ * netSessionAdvance()
+ * @parameter: s - session, pressing - this board's paddle button is down
+ * @return: 1 if the tick ran, 0 if the session is waiting for the peer
+ * A tick the remote input has not arrived for uses the last one that
+ * did. The state before the tick is kept for a rollback.
+ ****************************************************************************/
+RAMFUNC int netSessionAdvance(NetSession *s, uint8_t pressing)
+{
+    uint16_t n = s->tick;
+
+    if (!s->joined)
+        return 0;                  // no peer yet: nothing to step with
+
+    // Never get further ahead than the rollback window, and never
+    // drop an input the peer has not acknowledged
+    if (TICK_DIFF(n, s->remoteTick) >= NET_WINDOW - 1 ||
+        TICK_DIFF(n, s->peerAck) >= NET_WINDOW - 1) {
+        s->stats.stalls++;
+        return 0;
+    }
+
+    s->local[SLOT(n)] = pressing ? 1 : 0;
+    if (TICK_DIFF(n, s->remoteTick) >= 0)
+        s->remote[SLOT(n)] = s->lastRemote;
+
+    s->history[SLOT(n)] = s->game;
+    netGameStep(&s->game, netInputs(s, n));
+    s->tick = n + 1;
+    netLatchWin(s);
+    return 1;
+}
+
+/****************************************************************************
+ * netSessionPacket()
+ * @parameter: s - session, out - NET_PACKET_SIZE bytes
+ * @return: packet length
+ * Layout (little-endian): first tick (2), input count, input bits,
+ * ack = first remote tick still needed (2), check tick (2), hash of
+ * the state before the check tick, our session id (2), the peer's
+ * session id as we know it (2, 0 = none yet).
+ ****************************************************************************/
+uint8_t netSessionPacket(const NetSession *s, uint8_t *out)
+{
+    uint16_t first = s->peerAck;
+    uint16_t pending = (uint16_t)(s->tick - first);
+    uint8_t count = pending > NET_MAX_INPUTS ? NET_MAX_INPUTS : (uint8_t)pending;
+    uint8_t bits = 0;
+    uint16_t check = netConfirmed(s);
+
+    for (uint8_t k = 0; k < count; k++)
+        bits |= (uint8_t)(s->local[SLOT(first + k)] << k);
+
+    out[0] = (uint8_t)first;
+    out[1] = (uint8_t)(first >> 8);
+    out[2] = count;
+    out[3] = bits;
+    out[4] = (uint8_t)s->remoteTick;
+    out[5] = (uint8_t)(s->remoteTick >> 8);
+    out[6] = (uint8_t)check;
+    out[7] = (uint8_t)(check >> 8);
+    out[8] = netGameHash(netStateBefore(s, check));
+    out[9] = (uint8_t)s->id;
+    out[10] = (uint8_t)(s->id >> 8);
+    out[11] = (uint8_t)s->peerId;
+    out[12] = (uint8_t)(s->peerId >> 8);
+    return NET_PACKET_SIZE;
+}
+
+/****************************************************************************
+ * netSessionReceive()
+ * @parameter: s - session, in/len - packet from the other board
+ * @return: None
+ * Joins or restarts the session on the ids, then takes the inputs in
+ * order, re-guesses the ticks still ahead of them, and re-runs
+ * everything from the first tick that changed.
+ ****************************************************************************/
+void netSessionReceive(NetSession *s, const uint8_t *in, uint8_t len)
+{
+    uint16_t first, ack, check, n, sid, mine;
+    uint8_t count, bits, hash;
+    int16_t redo = -1;            // ticks back from s->tick to re-run from
+    uint8_t got = 0;
+
+    if (len != NET_PACKET_SIZE || in[2] > NET_MAX_INPUTS || (in[9] | in[10]) == 0) {
+        s->stats.badPackets++;
+        return;
+    }
+
+    sid  = (uint16_t)(in[9] | (in[10] << 8));
+    mine = (uint16_t)(in[11] | (in[12] << 8));
+    if (sid != s->peerId) {
+        if (mine != 0 && mine != s->id)
+            return;                // between sessions we have both left
+        if (s->peerId != 0)
+            netSessionRestart(s);  // the peer started over: so do we
+        s->peerId = sid;
+    }
+    if (mine != s->id)
+        return;                    // the peer does not have our id yet
+    s->joined = 1;
+
+    first = (uint16_t)(in[0] | (in[1] << 8));
+    count = in[2];
+    bits  = in[3];
+    ack   = (uint16_t)(in[4] | (in[5] << 8));
+    check = (uint16_t)(in[6] | (in[7] << 8));
+    hash  = in[8];
+
+    // What the peer already has of ours
+    if (TICK_DIFF(ack, s->peerAck) > 0 && TICK_DIFF(ack, s->tick) <= 0)
+        s->peerAck = ack;
+
+    // New remote inputs, strictly in order
+    if (TICK_DIFF(first, s->remoteTick) > 0) {
+        s->stats.badPackets++;     // gap: the next packet will cover it
+        count = 0;
+    }
+    for (uint8_t k = 0; k < count; k++) {
+        uint8_t bit = (bits >> k) & 1;
+
+        n = first + k;
+        if (n != s->remoteTick)
+            continue;                              // already have it
+        if (TICK_DIFF(n, s->tick) >= NET_WINDOW - 1)
+            break;                                 // too far ahead
+
+        if (TICK_DIFF(n, s->tick) < 0 && s->remote[SLOT(n)] != bit && redo < 0)
+            redo = TICK_DIFF(s->tick, n);
+        s->remote[SLOT(n)] = bit;
+        s->lastRemote = bit;
+        s->remoteTick = n + 1;
+        got = 1;
+    }
+
+    // Ticks still on a guess now guess the newest real input
+    for (n = s->remoteTick; got && TICK_DIFF(n, s->tick) < 0; n++) {
+        if (s->remote[SLOT(n)] != s->lastRemote) {
+            if (redo < 0)
+                redo = TICK_DIFF(s->tick, n);
+            s->remote[SLOT(n)] = s->lastRemote;
+        }
+    }
+
+    if (redo > 0) {
+        n = s->tick - (uint16_t)redo;
+        s->game = s->history[SLOT(n)];
+        for (; n != s->tick; n++) {
+            s->history[SLOT(n)] = s->game;
+            netGameStep(&s->game, netInputs(s, n));
+        }
+        s->stats.rollbacks++;
+        if ((uint32_t)redo > s->stats.maxDepth)
+            s->stats.maxDepth = (uint32_t)redo;
+    }
+
+    // Both boards have settled the state before `check`: compare
+    if (TICK_DIFF(check, netConfirmed(s)) <= 0 &&
+        TICK_DIFF(s->tick, check) < NET_WINDOW - 1 &&
+        netGameHash(netStateBefore(s, check)) != hash)
+        s->stats.desyncs++;
+
+    netLatchWin(s);
+}
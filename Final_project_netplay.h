@@ -0,0 +1,92 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+/*************************************************
+ * @file: netplay.h
+ *
+ * Header file for netplay.c
+ * Two-board Pong: a 16-cell court split over two boards (cells 0-7
+ * on player 1's LEDs, 8-15 on player 2's), run in lockstep with
+ * rollback. Each board owns one paddle and sends its input for
+ * every tick to the other board through link.c.
+ *
+ * Each board names its session with an id. Ticks only run once both
+ * boards have the other's id, and a board that sees the peer start a
+ * new session starts over with it, so a reset or a re-entered
+ * NET_MODE on one side resyncs both at tick 0.
+ *************************************************/
+
+#include <stdint.h>
+
+#define NET_CELLS       16
+#define NET_WIN_SCORE   3
+#define NET_WINDOW      16    // power of two: ticks kept for rollback
+#define NET_MAX_INPUTS  8     // inputs sent per packet
+#define NET_PACKET_SIZE 13
+
+// Inputs for one tick: bit 0 = player 1 pressing, bit 1 = player 2
+#define NET_IN_P1 0x01
+#define NET_IN_P2 0x02
+
+// The shared game. Only netGameStep() changes it.
+typedef struct {
+    int8_t  pos;           // ball cell, 0 = player 1's paddle
+    int8_t  dir;           // +1 toward player 2, -1 toward player 1, 0 = waiting to serve
+    uint8_t server;        // 0 = player 1, 1 = player 2
+    uint8_t score[2];
+    uint8_t winner;        // 1 or 2 in the state after the winning tick, else 0
+} NetGame;
+
+typedef struct {
+    uint32_t rollbacks;    // mispredictions corrected
+    uint32_t maxDepth;     // most ticks re-run by one rollback
+    uint32_t stalls;       // ticks skipped waiting for the other board
+    uint32_t desyncs;      // state checks that did not match
+    uint32_t badPackets;   // packets that did not fit the window
+    uint32_t resyncs;      // sessions restarted because the peer did
+} NetStats;
+
+typedef struct {
+    NetGame  game;                     // state before tick `tick`
+    uint16_t id;                       // this board's session, never 0
+    uint16_t peerId;                   // the other board's, 0 = none yet
+    uint8_t  joined;                   // the peer has our id: ticks run
+    uint8_t  winner;                   // settled win not taken yet (1 or 2)
+    uint16_t winTick;                  // the tick it was won on
+    uint16_t winSeen;                  // first settled tick not checked for a win
+    uint16_t tick;                     // next tick to run
+    uint16_t remoteTick;               // first tick without the remote input
+    uint16_t peerAck;                  // first local tick the peer lacks
+    uint8_t  localPlayer;              // 0 = player 1, 1 = player 2
+    uint8_t  lastRemote;               // newest real remote input (the guess)
+    uint8_t  local[NET_WINDOW];        // local input per tick
+    uint8_t  remote[NET_WINDOW];       // remote input per tick (predicted past remoteTick)
+    NetGame  history[NET_WINDOW];      // state before each tick
+    NetStats stats;
+} NetSession;
+
+void netGameReset(NetGame *g);
+void netGameStep(NetGame *g, uint8_t inputs);
+uint8_t netGameHash(const NetGame *g);
+
+// id names the session (0 is taken as 1); a new session needs a new id
+void netSessionInit(NetSession *s, uint8_t localPlayer, uint16_t id);
+
+// One game tick with this board's input. Returns 0 (and does not
+// run the tick) before the boards have joined, or while the other
+// board is NET_WINDOW ticks behind.
+int netSessionAdvance(NetSession *s, uint8_t pressing);
+
+// Newest state both boards have the inputs for: no rollback changes it
+const NetGame *netSessionSettled(const NetSession *s);
+
+// A win in the settled state, once: returns the winner (0 = none)
+uint8_t netSessionTakeWin(NetSession *s);
+
+// Packet for the other board: every input it has not acknowledged
+uint8_t netSessionPacket(const NetSession *s, uint8_t *out);
+
+// A packet from the other board; rolls back if a prediction was wrong
+void netSessionReceive(NetSession *s, const uint8_t *in, uint8_t len);
+
+#endif
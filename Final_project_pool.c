@@ -0,0 +1,87 @@
+#include "pool.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: pool.c
+ * @brief: Fixed-size block allocator
+ *
+ * Free blocks form a singly linked list through their own first
+ * word, so a pool costs nothing beyond its blocks and one Pool.
+ * Blocks that were never used are taken in order from `fresh`,
+ * which means a pool needs no init call: POOL_DEFINE is enough.
+ * Both paths are O(1). PRIMASK is held for the few instructions
+ * that touch the list, so a game step or ISR can allocate while a
+ * task is freeing.
+ *===============================================================*/
+
+Pool *poolFirst = 0;
+
+/****************************************************************************
+ * poolAlloc()
+ * @parameter: pool - POOL_DEFINE pool
+ * @return: a block, or NULL if every block is in use
+ ****************************************************************************/
+RAMFUNC void *poolAlloc(Pool *pool)
+{
+    uint32_t primask = __get_PRIMASK();
+    void *block = 0;
+
+    __disable_irq();
+
+    if (!pool->listed) {
+        pool->next = poolFirst;
+        poolFirst = pool;
+        pool->listed = 1;
+    }
+
+    if (pool->freeList) {
+        block = pool->freeList;
+        pool->freeList = *(void **)block;
+    }
+    else if (pool->fresh < pool->capacity) {
+        block = pool->blocks + (uint32_t)pool->fresh * pool->blockSize;
+        pool->fresh++;
+    }
+
+    if (block) {
+        pool->used++;
+        if (pool->used > pool->highWater)
+            pool->highWater = pool->used;
+    }
+    else {
+        pool->exhausted++;
+    }
+
+    __set_PRIMASK(primask);
+    return block;
+}
+
+/****************************************************************************
+ * poolFree()
+ * @parameter: pool - the pool it came from, block - from poolAlloc()
+ * @return: None
+ * A pointer outside the pool's blocks is counted and ignored.
+ ****************************************************************************/
+RAMFUNC void poolFree(Pool *pool, void *block)
+{
+    uint8_t *p = block;
+    uint32_t offset;
+    uint32_t primask;
+
+    offset = (uint32_t)(p - pool->blocks);
+    if (!block || p < pool->blocks || offset % pool->blockSize != 0 ||
+        offset / pool->blockSize >= pool->fresh) {
+        pool->badFrees++;
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    *(void **)block = pool->freeList;
+    pool->freeList = block;
+    pool->used--;
+
+    __set_PRIMASK(primask);
+}
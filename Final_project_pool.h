@@ -0,0 +1,50 @@
+#ifndef POOL_H
+#define POOL_H
+
+/*************************************************
+ * @file: pool.h
+ *
+ * Header file for pool.c
+ * Fixed-capacity object pools: no heap, sized at compile time,
+ * O(1) alloc and free from threads and interrupts alike.
+ *
+ *   POOL_DEFINE(timerPool, SoftTimer, 8);   // file scope
+ *   SoftTimer *t = poolAlloc(&timerPool);   // NULL when exhausted
+ *   poolFree(&timerPool, t);
+ *
+ * Every pool that has been used is on the poolFirst list, so its
+ * usage can be read at run time (debugger or a diagnostics mode).
+ *************************************************/
+
+#include <stdint.h>
+
+typedef struct Pool {
+    const char *name;
+    uint8_t *blocks;
+    uint16_t blockSize;
+    uint16_t capacity;
+    uint16_t fresh;          // blocks from here on were never handed out
+    uint16_t used;
+    uint16_t highWater;      // most blocks in use at once
+    uint32_t exhausted;      // allocations refused
+    uint32_t badFrees;       // frees of pointers not from this pool
+    void *freeList;
+    struct Pool *next;       // poolFirst list
+    uint8_t listed;
+} Pool;
+
+// Defines a static pool of count blocks of type. Each block is at
+// least a pointer (the free list runs through free blocks).
+#define POOL_DEFINE(pool, type, count)                                     \
+    _Static_assert((count) > 0 && (count) < 0xFFFF, #pool " size");        \
+    static union { type item; void *link; } pool##Blocks[count];           \
+    static Pool pool = { #pool, (uint8_t *)pool##Blocks,                   \
+                         sizeof(pool##Blocks[0]), (count),                 \
+                         0, 0, 0, 0, 0, 0, 0, 0 }
+
+extern Pool *poolFirst;
+
+void *poolAlloc(Pool *pool);
+void poolFree(Pool *pool, void *block);
+
+#endif
@@ -0,0 +1,196 @@
+#include "sampler.h"
+#include "debounce.h"
+#include "irq.h"
+#include "wcet.h"
+#include "debounce_bench.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: sampler.c
+ * @brief: Timer-triggered DMA sampling of the button port
+ *
+ * Every TIM16 update requests one DMA1 channel 6 transfer: the low
+ * half-word of GPIOC->IDR goes into the next slot of a circular
+ * buffer. The CPU is only involved at the half-transfer and
+ * transfer-complete interrupts, each of which debounces the
+ * SAMPLER_BATCH samples of the finished half while DMA fills the
+ * other one. That is 62 interrupts a second for 2000 samples, where
+ * the TIM2 filter took 67 interrupts for 67 samples.
+ *
+ * All three buttons (PC0, PC1, PC13) are on port C, so one stream
+ * covers them; each pin is one lane of the batch debouncer.
+ *
+ * Timestamps: TIM16 and TIM5 both count the 4 MHz clock, so the
+ * time of any sample follows from TIM5 now, TIM16's count since
+ * the latest sample, and how many samples ago it was taken.
+ *===============================================================*/
+
+#define SAMPLER_BUF_LEN    (2 * SAMPLER_BATCH)
+#define SAMPLER_TIMER_CLK  4000000  // TIM16 kernel clock, same as TIM5
+#define SAMPLER_PERIOD     (SAMPLER_TIMER_CLK / SAMPLER_RATE)
+#define DMA_REQ_TIM16_UP   4        // DMA1 channel 6 request for TIM16_UP
+#define BENCH_STRIDE       (SAMPLER_RATE * BENCH_SAMPLE_US / 1000000)
+
+NOINIT static volatile uint16_t idrSamples[SAMPLER_BUF_LEN];  // DMA fills first
+
+static BatchDebouncer debouncer;
+static uint8_t laneButton[DEBOUNCE_BATCH_LANES];
+
+volatile SamplerStats samplerStats;
+volatile uint32_t samplerEdgeTime[NUM_BUTTONS];
+
+/****************************************************************************
+ * initLanes()
+ * @parameter: None
+ * @return: None
+ * One debouncer lane per button pin, all released.
+ ****************************************************************************/
+static void initLanes(void)
+{
+    uint16_t mask = 0;
+
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        mask |= (uint16_t)(1U << buttons[i].pin);
+        laneButton[buttons[i].pin] = i;
+    }
+    debounceBatchInit(&debouncer, mask);
+}
+
+/****************************************************************************
+ * init_Sampler()
+ * @parameter: None
+ * @return: None
+ * DMA1 channel 6 circular from GPIOC->IDR, then TIM16 started as the
+ * sample clock. The buttons start released.
+ ****************************************************************************/
+void init_Sampler(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB2ENR |= RCC_APB2ENR_TIM16EN;
+
+    initLanes();
+
+    // --- DMA1 channel 6 (request 4 = TIM16_UP): IDR -> idrSamples[] ---
+    DMA1_CSELR->CSELR = (DMA1_CSELR->CSELR & ~DMA_CSELR_C6S) |
+                        (DMA_REQ_TIM16_UP << DMA_CSELR_C6S_Pos);
+    DMA1_Channel6->CCR = 0;
+    DMA1_Channel6->CPAR = (uint32_t)&GPIOC->IDR;
+    DMA1_Channel6->CMAR = (uint32_t)idrSamples;
+    DMA1_Channel6->CNDTR = SAMPLER_BUF_LEN;
+    DMA1_Channel6->CCR = DMA_CCR_MINC | DMA_CCR_CIRC |
+                         DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 |
+                         DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+    irqStatsSetPeriod(IRQ_STAT_INPUT, SAMPLER_PERIOD * SAMPLER_BATCH);
+    NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+
+    // --- TIM16: one DMA request per update ---
+    TIM16->PSC = 0;
+    TIM16->ARR = SAMPLER_PERIOD - 1;
+    TIM16->DIER |= TIM_DIER_UDE;
+    TIM16->CR1 |= TIM_CR1_CEN;
+}
+
+/****************************************************************************
+ * runBatch()
+ * @parameter: half - first sample of the finished half-buffer
+ * @return: None
+ ****************************************************************************/
+static RAMFUNC void runBatch(const volatile uint16_t *half)
+{
+    BatchEdge edges[SAMPLER_MAX_EDGES];
+    uint32_t now, sinceLast, written, behind, lastSample, lastTime;
+    uint8_t n;
+
+    // Samples the DMA has taken since the last one of this half
+    sinceLast = TIM16->CNT;
+    written = SAMPLER_BUF_LEN - DMA1_Channel6->CNDTR;
+    now = TIM5->CNT;
+    behind = (written + SAMPLER_BUF_LEN -
+              (uint32_t)(half - idrSamples) - SAMPLER_BATCH) % SAMPLER_BUF_LEN;
+    lastTime = now - sinceLast - behind * SAMPLER_PERIOD;
+    lastSample = debouncer.sample + SAMPLER_BATCH - 1;
+
+    n = debounceBatch(&debouncer, half, SAMPLER_BATCH, edges, SAMPLER_MAX_EDGES);
+
+#ifdef DEBOUNCE_BENCH
+    // Raw left-button stream for the bench's recorded profile
+    for (uint8_t i = 0; i < SAMPLER_BATCH; i += BENCH_STRIDE)
+        debounceBenchRecord((half[i] >> BENCH_RECORD_PIN) & 1U);
+#endif
+
+    samplerStats.batches++;
+    if (n == 0 && debouncer.settling == 0)
+        samplerStats.idleBatches++;
+
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t b = laneButton[edges[i].lane];
+
+        buttons[b].state = edges[i].level;
+        samplerEdgeTime[b] = lastTime - (lastSample - edges[i].sample) * SAMPLER_PERIOD;
+        samplerStats.edges++;
+        samplerEdge(b);
+    }
+}
+
+/****************************************************************************
+ * DMA1_Channel6_IRQHandler()
+ * @parameter: None
+ * @return: None
+ * Half-transfer: the first half is complete. Transfer-complete: the
+ * second half is. Entry latency is TIM16's count since the sample
+ * that raised the flag.
+ ****************************************************************************/
+RAMFUNC void DMA1_Channel6_IRQHandler(void)
+{
+    uint32_t start = WCET_START();
+    uint32_t isr = DMA1->ISR;
+
+    irqStatsEntry(IRQ_STAT_INPUT, TIM16->CNT);
+
+    if (isr & DMA_ISR_HTIF6) {
+        DMA1->IFCR = DMA_IFCR_CHTIF6;
+        runBatch(&idrSamples[0]);
+    }
+    if (isr & DMA_ISR_TCIF6) {
+        DMA1->IFCR = DMA_IFCR_CTCIF6;
+        runBatch(&idrSamples[SAMPLER_BATCH]);
+    }
+
+    wcetStop(WCET_INPUT, start);
+}
+
+#ifdef WCET_BENCH
+/****************************************************************************
+ * samplerWcetBench()
+ * @parameter: None
+ * @return: None
+ * Every button lane flips on every sample (no edge is ever confirmed,
+ * all lanes stay in the slow loop), then one batch held pressed
+ * confirms an edge on each. Call with the DMA not yet running; the
+ * debouncer is reset afterwards.
+ ****************************************************************************/
+void samplerWcetBench(void)
+{
+    uint32_t start;
+    uint16_t mask;
+
+    initLanes();
+    mask = debouncer.mask;
+
+    for (uint16_t i = 0; i < SAMPLER_BATCH; i++) {
+        idrSamples[i] = (i & 1U) ? mask : 0;
+        idrSamples[SAMPLER_BATCH + i] = 0;
+    }
+
+    start = WCET_START();
+    runBatch(&idrSamples[0]);
+    wcetStop(WCET_INPUT, start);
+
+    start = WCET_START();
+    runBatch(&idrSamples[SAMPLER_BATCH]);
+    wcetStop(WCET_INPUT, start);
+
+    initLanes();
+}
+#endif
@@ -0,0 +1,45 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+/*************************************************
+ * @file: sampler.h
+ *
+ * Header file for sampler.c
+ * Button input by DMA: TIM16 triggers a copy of GPIOC->IDR into a
+ * circular buffer SAMPLER_RATE times a second, and the buttons are
+ * debounced a half-buffer at a time (debounceBatch() in debounce.c).
+ * Results land in buttons[].state like before; each confirmed edge
+ * also gets a TIM5 timestamp to one sample period.
+ *************************************************/
+
+#include <stdint.h>
+#include "buttons.h"
+
+#define SAMPLER_RATE      2000   // port samples per second (500 us apart)
+#define SAMPLER_BATCH     32     // samples per half-buffer: one IRQ per 16 ms
+#define SAMPLER_MAX_EDGES 8      // edges taken from one batch
+
+typedef struct {
+    uint32_t batches;
+    uint32_t idleBatches;  // no raw edge and nothing settling
+    uint32_t edges;        // debounced edges
+} SamplerStats;
+
+extern volatile SamplerStats samplerStats;
+
+// TIM5 count of the latest debounced edge, by button
+extern volatile uint32_t samplerEdgeTime[NUM_BUTTONS];
+
+// After init_Buttons() and init_Capture() (TIM5)
+void init_Sampler(void);
+
+// Supplied by the application: called from the DMA interrupt after
+// each debounced edge, with buttons[button].state already updated
+void samplerEdge(uint8_t button);
+
+#ifdef WCET_BENCH
+// Times a worst-case batch (every button chattering) under WCET_INPUT
+void samplerWcetBench(void);
+#endif
+
+#endif
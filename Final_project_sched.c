@@ -0,0 +1,275 @@
+#include "sched.h"
+#include "tickless.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: sched.c
+ * @brief: Earliest-deadline-first task scheduler with WFI idle
+ *
+ * Tasks run one at a time in thread mode and always to completion,
+ * so they share data without locks. Interrupts still preempt them,
+ * and the game step keeps running in PendSV above all tasks.
+ *
+ * Every release gives the task an absolute deadline (release time +
+ * its deadline). The ready task with the earliest one runs next.
+ * A run that ends past its deadline counts as a miss. A periodic
+ * task that is still ready at its next release has overrun; that
+ * release is dropped and counted as skipped.
+ *
+ * With nothing ready the core sleeps in WFI. TIM5 compare channel 2
+ * is set to the next timed release so the sleep ends in time;
+ * any other interrupt that posts a task also ends it. PRIMASK is
+ * held across the last check and the WFI, so a post that lands
+ * in between still wakes the core.
+ *===============================================================*/
+
+// Signed distance a - b for the wrapping 32-bit TIM5 count
+#define TIME_DIFF(a, b) ((int32_t)((a) - (b)))
+
+volatile SchedStats schedStats[SCHED_MAX_TASKS];
+volatile uint32_t schedSleeps;
+volatile uint32_t schedIdle;
+
+static const SchedTask *taskTable;
+static uint8_t numTasks;
+static uint32_t nextRelease[SCHED_MAX_TASKS];
+static volatile uint32_t deadlineAt[SCHED_MAX_TASKS];
+static volatile uint32_t readyMask;
+static volatile uint32_t postAt[SCHED_MAX_TASKS];
+static volatile uint32_t postAtMask;     // tasks with a schedPostAt() pending
+static volatile uint8_t rescan;          // schedPostAt() since releaseDue()
+
+/****************************************************************************
+ * schedInit()
+ * @parameter: tasks, count - the task table
+ * @return: None
+ * Every periodic task is released right away. TIM5 must already be
+ * running (init_Capture()).
+ ****************************************************************************/
+void schedInit(const SchedTask *tasks, uint8_t count)
+{
+    uint32_t now = TIM5->CNT;
+
+    taskTable = tasks;
+    numTasks = (count > SCHED_MAX_TASKS) ? SCHED_MAX_TASKS : count;
+    readyMask = 0;
+    postAtMask = 0;
+
+    for (uint8_t i = 0; i < numTasks; i++)
+        nextRelease[i] = now;
+
+    // Channel 2 as a plain compare (frozen output), interrupt only
+    TIM5->CCMR1 &= ~(TIM_CCMR1_CC2S | TIM_CCMR1_OC2M);
+    TIM5->SR = ~TIM_SR_CC2IF;
+    TIM5->DIER |= TIM_DIER_CC2IE;
+    NVIC_EnableIRQ(TIM5_IRQn);
+}
+
+/****************************************************************************
+ * schedPost()
+ * @parameter: task - task id
+ * @return: None
+ * A task that is already ready keeps its earlier deadline. Posts
+ * before schedInit() (e.g. from the WCET bench) are ignored.
+ ****************************************************************************/
+RAMFUNC void schedPost(uint8_t task)
+{
+    uint32_t primask;
+
+    if (task >= numTasks)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!(readyMask & (1UL << task))) {
+        deadlineAt[task] = TIM5->CNT + taskTable[task].deadline;
+        readyMask |= 1UL << task;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/****************************************************************************
+ * schedPostAt()
+ * @parameter: task - task id, when - TIM5 count to release it at
+ * @return: None
+ * If the core is asleep, the interrupt this is called from has
+ * already woken it, and schedRun() picks up the new release time.
+ ****************************************************************************/
+RAMFUNC void schedPostAt(uint8_t task, uint32_t when)
+{
+    uint32_t primask;
+    uint32_t bit = 1UL << task;
+
+    if (task >= numTasks)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!(postAtMask & bit) || TIME_DIFF(when, postAt[task]) < 0)
+        postAt[task] = when;
+    postAtMask |= bit;
+    rescan = 1;
+
+    __set_PRIMASK(primask);
+}
+
+/****************************************************************************
+ * releaseDue()
+ * @parameter: now - TIM5 count
+ * @return: TIM5 count of the next timed release
+ ****************************************************************************/
+static uint32_t releaseDue(uint32_t now)
+{
+    uint32_t next = now + 0x7FFFFFFFUL;
+
+    for (uint8_t i = 0; i < numTasks; i++) {
+        uint32_t period = taskTable[i].period;
+        uint32_t bit = 1UL << i;
+
+        __disable_irq();
+        if (postAtMask & bit) {
+            if (TIME_DIFF(now, postAt[i]) >= 0) {
+                postAtMask &= ~bit;
+                if (!(readyMask & bit)) {
+                    deadlineAt[i] = postAt[i] + taskTable[i].deadline;
+                    readyMask |= bit;
+                }
+            }
+            else if (TIME_DIFF(postAt[i], next) < 0) {
+                next = postAt[i];
+            }
+        }
+        __enable_irq();
+
+        if (period == 0)
+            continue;
+
+        if (TIME_DIFF(now, nextRelease[i]) >= 0) {
+            __disable_irq();
+            if (readyMask & bit) {
+                schedStats[i].skipped++;       // last release never ran
+            }
+            else {
+                deadlineAt[i] = nextRelease[i] + taskTable[i].deadline;
+                readyMask |= bit;
+            }
+            __enable_irq();
+
+            nextRelease[i] += period;
+            if (TIME_DIFF(now, nextRelease[i]) >= 0)
+                nextRelease[i] = now + period; // far behind: realign
+        }
+
+        if (TIME_DIFF(nextRelease[i], next) < 0)
+            next = nextRelease[i];
+    }
+    return next;
+}
+
+/****************************************************************************
+ * pickEarliest()
+ * @parameter: None
+ * @return: ready task with the earliest deadline, or -1
+ ****************************************************************************/
+static int pickEarliest(void)
+{
+    uint32_t ready = readyMask;
+    int best = -1;
+
+    for (uint8_t i = 0; i < numTasks; i++) {
+        if (!(ready & (1UL << i)))
+            continue;
+        if (best < 0 || TIME_DIFF(deadlineAt[i], deadlineAt[best]) < 0)
+            best = i;
+    }
+    return best;
+}
+
+/****************************************************************************
+ * runTask()
+ * @parameter: id - task to run
+ * @return: None
+ ****************************************************************************/
+static void runTask(uint8_t id)
+{
+    volatile SchedStats *st = &schedStats[id];
+    uint32_t start, cycles;
+    int32_t late;
+
+    __disable_irq();
+    readyMask &= ~(1UL << id);
+    __enable_irq();
+
+    start = DWT->CYCCNT;
+    taskTable[id].run();
+    cycles = DWT->CYCCNT - start;
+
+    st->runs++;
+    st->lastCycles = cycles;
+    if (cycles > st->worstCycles)
+        st->worstCycles = cycles;
+
+    late = TIME_DIFF(TIM5->CNT, deadlineAt[id]);
+    if (late > 0) {
+        st->misses++;
+        if ((uint32_t)late > st->worstLate)
+            st->worstLate = (uint32_t)late;
+    }
+}
+
+/****************************************************************************
+ * schedRun()
+ * @parameter: None
+ * @return: never
+ ****************************************************************************/
+void schedRun(void)
+{
+    while (1)
+    {
+        uint32_t next;
+        int id;
+
+        rescan = 0;
+        next = releaseDue(TIM5->CNT);
+        id = pickEarliest();
+
+        if (id >= 0) {
+            runTask((uint8_t)id);
+            continue;
+        }
+
+        // Nothing ready: sleep until the next release or a post
+        TIM5->CCR2 = next;
+        TIM5->SR = ~TIM_SR_CC2IF;   // rc_w0: a plain write never drops CC1IF
+
+        __disable_irq();
+        if (readyMask == 0 && !rescan && TIME_DIFF(next, TIM5->CNT) > 0) {
+            uint32_t sleptAt = TIM5->CNT;
+
+            schedSleeps++;
+            __DSB();
+            __WFI();
+            schedIdle += TIM5->CNT - sleptAt;   // before the waking ISR runs
+        }
+        __enable_irq();
+    }
+}
+
+/****************************************************************************
+ * TIM5_IRQHandler()
+ * @parameter: None
+ * @return: None
+ * Compare 2 only ends the WFI; schedRun() does the release. Compare 1
+ * belongs to the tickless game events (tickless.c).
+ ****************************************************************************/
+RAMFUNC void TIM5_IRQHandler(void)
+{
+    if (TIM5->SR & TIM_SR_CC2IF)
+        TIM5->SR = ~TIM_SR_CC2IF;
+
+    ticklessIrq();
+}
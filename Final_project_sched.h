@@ -0,0 +1,52 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+/*************************************************
+ * @file: sched.h
+ *
+ * Header file for sched.c
+ * Cooperative run-to-completion scheduler for the main loop.
+ * Tasks are released by a period, by schedPost() (from an ISR or
+ * a task), at a set time by schedPostAt(), or any mix, and the ready task with the earliest absolute
+ * deadline runs first (EDF). Times are TIM5 counts (capture.h),
+ * 4 per microsecond.
+ *************************************************/
+
+#include <stdint.h>
+
+#define SCHED_MAX_TASKS    8
+#define SCHED_COUNTS_PER_MS 4000   // TIM5 at 4 MHz
+
+typedef struct {
+    void (*run)(void);
+    uint32_t period;      // counts between releases, 0 = only on schedPost()
+    uint32_t deadline;    // counts from release to completion
+} SchedTask;
+
+typedef struct {
+    uint32_t runs;
+    uint32_t lastCycles;  // execution time of the latest run
+    uint32_t worstCycles;
+    uint32_t misses;      // runs that finished after their deadline
+    uint32_t worstLate;   // counts past the deadline, worst case
+    uint32_t skipped;     // periodic releases lost to an overrun
+} SchedStats;
+
+extern volatile SchedStats schedStats[SCHED_MAX_TASKS];
+extern volatile uint32_t schedSleeps;   // times the core went to WFI
+extern volatile uint32_t schedIdle;     // TIM5 counts spent in WFI, wraps
+
+// tasks[] must stay valid; index = task id, lower id wins a deadline tie
+void schedInit(const SchedTask *tasks, uint8_t count);
+
+// Make a task ready now (safe from any interrupt)
+void schedPost(uint8_t task);
+
+// Make a task ready at TIM5 count `when`; of several pending
+// requests the earliest wins (safe from any interrupt)
+void schedPostAt(uint8_t task, uint32_t when);
+
+// Runs the tasks forever and sleeps when none is ready
+void schedRun(void);
+
+#endif
@@ -0,0 +1,116 @@
+#include "sound.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: sound.c
+ * @brief: Sound effects by DAC + DMA playback
+ *
+ * TIM6 runs at SOUND_RATE with its update event as TRGO. Every TRGO
+ * makes DAC1 channel 1 output the sample held in DHR8R1 and request
+ * the next one, which DMA1 channel 3 (request 6) copies from the
+ * effect's table. So once soundPlay() has pointed the channel at a
+ * table, the effect plays with no CPU at all. The only interrupt is
+ * the transfer-complete at the end, which stops TIM6.
+ *
+ * Tables are bytes; DMA widens each to the 32-bit DHR8R1 write the
+ * DAC needs (MSIZE 8, PSIZE 32).
+ *
+ * The channel is not circular: a circular channel would loop the
+ * effect, and stopping it would still take the same interrupt.
+ *===============================================================*/
+
+#define SOUND_NONE       NUM_SOUNDS
+#define DMA_REQ_DAC_CH1  6          // DMA1 channel 3 request for DAC1 channel 1
+
+static volatile uint8_t playing = SOUND_NONE;
+
+/****************************************************************************
+ * init_Sound()
+ * @parameter: None
+ * @return: None
+ * PA4 analog, DAC1 channel 1 triggered by TIM6 TRGO with DMA requests,
+ * resting at midscale. TIM6 only runs while an effect plays.
+ ****************************************************************************/
+void init_Sound(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN;
+    RCC->APB1ENR1 |= RCC_APB1ENR1_DAC1EN | RCC_APB1ENR1_TIM6EN;
+
+    // --- PA4: analog mode, DAC1_OUT1 ---
+    GPIOA->MODER |= GPIO_MODER_MODE4;
+
+    // --- DMA1 channel 3 (request 6 = DAC_CH1): table -> DHR8R1 ---
+    DMA1_CSELR->CSELR = (DMA1_CSELR->CSELR & ~DMA_CSELR_C3S) |
+                        (DMA_REQ_DAC_CH1 << DMA_CSELR_C3S_Pos);
+    DMA1_Channel3->CCR = 0;
+    DMA1_Channel3->CPAR = (uint32_t)&DAC1->DHR8R1;
+    playing = SOUND_NONE;         // a play before init never completes
+    NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
+    // --- DAC1 channel 1: TSEL1 = 000 (TIM6 TRGO), DMA on ---
+    DAC1->DHR8R1 = 128;
+    DAC1->CR = (DAC1->CR & ~DAC_CR_TSEL1) | DAC_CR_TEN1 | DAC_CR_DMAEN1 | DAC_CR_EN1;
+
+    // --- TIM6: update event as TRGO, SOUND_RATE a second ---
+    TIM6->PSC = 0;
+    TIM6->ARR = SOUND_PERIOD - 1;
+    TIM6->CR2 = TIM_CR2_MMS_1;
+}
+
+/****************************************************************************
+ * soundPlay()
+ * @parameter: id - effect to play
+ * @return: None
+ * Restarts the DMA channel on the effect's table and starts TIM6.
+ * Ignored while an effect of higher priority is playing.
+ ****************************************************************************/
+RAMFUNC void soundPlay(SoundId id)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (playing == SOUND_NONE || playing <= id) {
+        TIM6->CR1 &= ~TIM_CR1_CEN;
+        DMA1_Channel3->CCR = 0;
+        DMA1->IFCR = DMA_IFCR_CTCIF3;
+
+        DMA1_Channel3->CMAR = (uint32_t)soundTables[id].samples;
+        DMA1_Channel3->CNDTR = soundTables[id].length;
+        DMA1_Channel3->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_1 |
+                             DMA_CCR_TCIE | DMA_CCR_EN;
+        playing = id;
+
+        TIM6->CNT = 0;
+        TIM6->CR1 |= TIM_CR1_CEN;
+    }
+    __set_PRIMASK(primask);
+}
+
+/****************************************************************************
+ * soundBusy()
+ * @parameter: None
+ * @return: 1 while an effect is playing
+ ****************************************************************************/
+uint8_t soundBusy(void)
+{
+    return playing != SOUND_NONE;
+}
+
+/****************************************************************************
+ * DMA1_Channel3_IRQHandler()
+ * @parameter: None
+ * @return: None
+ * The last sample of the table is in the DAC: stop the trigger. The
+ * table ends at midscale, so the output rests there.
+ ****************************************************************************/
+RAMFUNC void DMA1_Channel3_IRQHandler(void)
+{
+    if (DMA1->ISR & DMA_ISR_TCIF3) {
+        DMA1->IFCR = DMA_IFCR_CTCIF3;
+        TIM6->CR1 &= ~TIM_CR1_CEN;
+        DMA1_Channel3->CCR = 0;
+        playing = SOUND_NONE;
+    }
+}
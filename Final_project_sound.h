@@ -0,0 +1,43 @@
+#ifndef SOUND_H
+#define SOUND_H
+
+/*************************************************
+ * @file: sound.h
+ *
+ * Header file for sound.c
+ * Sound effects on DAC1 channel 1 (PA4). Each effect is a waveform
+ * table in flash (sound_tables.c, generated by tools/sound_gen.py)
+ * that TIM6 paces into the DAC through DMA1 channel 3, so playback
+ * takes no CPU; one interrupt at the end stops the timer.
+ *************************************************/
+
+#include <stdint.h>
+
+#define SOUND_RATE      8000      // samples per second
+#define SOUND_TIMER_CLK 4000000   // TIM6 kernel clock
+#define SOUND_PERIOD    (SOUND_TIMER_CLK / SOUND_RATE)
+
+// In priority order: an effect cuts off one below it, never one above
+typedef enum {
+    SOUND_HIT,
+    SOUND_MISS,
+    SOUND_WIN,
+    NUM_SOUNDS
+} SoundId;
+
+typedef struct {
+    const uint8_t *samples;   // 8-bit, 128 = silence
+    uint16_t length;
+} SoundTable;
+
+extern const SoundTable soundTables[NUM_SOUNDS];
+
+void init_Sound(void);
+
+// Starts an effect and returns at once. Safe from the game step.
+void soundPlay(SoundId id);
+
+// 1 while an effect is playing
+uint8_t soundBusy(void);
+
+#endif
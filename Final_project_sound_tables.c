@@ -0,0 +1,564 @@
+#include "sound.h"
+
+/*=================================================================
+ * @file: sound_tables.c
+ * @brief: Sound effect waveforms (generated by tools/sound_gen.py)
+ *
+ * Do not edit: change the notes in the generator and run
+ *   tools/sound_gen.py > Final_project_sound_tables.c
+ *===============================================================*/
+
+_Static_assert(SOUND_RATE == 8000, "tables are for 8000 Hz: rerun tools/sound_gen.py");
+
+static const uint8_t hitSamples[403] = {
+    128, 188, 187, 187, 187,  69,  69,  69, 186, 186, 186,  70,  70,  70,  70, 185,
+    185, 185,  71,  71,  71, 185, 184, 184, 184,  72,  72,  72, 183, 183, 183,  73,
+     73,  73,  73, 182, 182, 182,  74,  74,  74, 182, 181, 181, 181,  75,  75,  75,
+    180, 180, 180,  76,  76,  76,  76, 179, 179, 179,  77,  77,  77, 179, 178, 178,
+    178,  78,  78,  78, 177, 177, 177,  79,  79,  79,  79, 176, 176, 176,  80,  80,
+     80, 176, 175, 175, 175,  81,  81,  81, 174, 174, 174,  82,  82,  82,  82, 173,
+    173, 173,  83,  83,  83, 173, 172, 172, 172,  84,  84,  84, 171, 171, 171,  85,
+     85,  85,  85, 170, 170, 170,  86,  86,  86, 170, 169, 169, 169,  87,  87,  87,
+    168, 168, 168,  88,  88,  88,  88, 167, 167, 167,  89,  89,  89, 167, 166, 166,
+    166,  90,  90,  90, 165, 165, 165,  91,  91,  91,  91, 164, 164, 164,  92,  92,
+     92, 164, 163, 163, 163,  93,  93,  93, 162, 162, 162,  94,  94,  94,  94, 161,
+    161, 161,  95,  95,  95, 161, 160, 160, 160,  96,  96,  96, 159, 159, 159,  97,
+     97,  97,  97, 158, 158, 158,  98,  98,  98, 158, 157, 157, 157,  99,  99,  99,
+    156, 156, 156, 100, 100, 100, 100, 155, 155, 155, 101, 101, 101, 155, 154, 154,
+    154, 102, 102, 102, 153, 153, 153, 103, 103, 103, 103, 152, 152, 152, 104, 104,
+    104, 152, 151, 151, 151, 105, 105, 105, 150, 150, 150, 106, 106, 106, 106, 149,
+    149, 149, 107, 107, 107, 149, 148, 148, 148, 108, 108, 108, 147, 147, 147, 109,
+    109, 109, 109, 146, 146, 146, 110, 110, 110, 146, 145, 145, 145, 111, 111, 111,
+    144, 144, 144, 112, 112, 112, 112, 143, 143, 143, 113, 113, 113, 143, 142, 142,
+    142, 114, 114, 114, 141, 141, 141, 115, 115, 115, 115, 140, 140, 140, 116, 116,
+    116, 140, 139, 139, 139, 117, 117, 117, 138, 138, 138, 118, 118, 118, 118, 137,
+    137, 137, 119, 119, 119, 137, 136, 136, 136, 120, 120, 120, 135, 135, 135, 121,
+    121, 121, 121, 134, 134, 134, 122, 122, 122, 134, 133, 133, 133, 123, 123, 123,
+    132, 132, 132, 124, 124, 124, 124, 131, 131, 131, 125, 125, 125, 131, 130, 130,
+    130, 126, 126, 126, 129, 129, 129, 127, 127, 127, 127, 128, 128, 128, 128, 128,
+    128, 128, 128,
+};
+
+static const uint8_t missSamples[2643] = {
+    128, 188, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,  69,  69,  70,  70,
+     70,  70,  70,  70,  70,  70, 186, 186, 186, 186, 185, 185, 185, 185, 185, 185,
+     71,  71,  71,  71,  71,  71,  72,  72,  72,  72, 184, 184, 184, 184, 184, 184,
+    184, 184, 183, 183, 183,  73,  73,  73,  73,  73,  73,  73,  73,  73,  74, 182,
+    182, 182, 182, 182, 182, 182, 182, 182, 182,  74,  75,  75,  75,  75,  75,  75,
+     75,  75,  75, 181, 181, 181, 180, 180, 180, 180, 180, 180, 180,  76,  76,  76,
+     76,  76,  77,  77,  77,  77,  77,  77, 179, 179, 179, 179, 179, 179, 178, 178,
+    178, 178,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79, 177, 177, 177, 177,
+    177, 177, 177, 177, 177, 177,  80,  80,  80,  80,  80,  80,  80,  80,  80,  80,
+    176, 176, 175, 175, 175, 175, 175, 175, 175, 175, 175,  81,  81,  81,  82,  82,
+     82,  82,  82,  82,  82, 174, 174, 174, 174, 174, 173, 173, 173, 173, 173,  83,
+     83,  83,  83,  83,  83,  83,  84,  84,  84, 172, 172, 172, 172, 172, 172, 172,
+    172, 172, 171,  85,  85,  85,  85,  85,  85,  85,  85,  85,  85,  85, 170, 170,
+    170, 170, 170, 170, 170, 170, 170, 170,  86,  86,  87,  87,  87,  87,  87,  87,
+     87,  87, 169, 169, 169, 169, 168, 168, 168, 168, 168, 168,  88,  88,  88,  88,
+     88,  88,  89,  89,  89,  89, 167, 167, 167, 167, 167, 167, 167, 167, 166, 166,
+    166,  90,  90,  90,  90,  90,  90,  90,  90,  90,  91, 165, 165, 165, 165, 165,
+    165, 165, 165, 165, 165,  91,  92,  92,  92,  92,  92,  92,  92,  92,  92, 164,
+    164, 164, 163, 163, 163, 163, 163, 163, 163,  93,  93,  93,  93,  93,  94,  94,
+     94,  94,  94,  94, 162, 162, 162, 162, 162, 162, 161, 161, 161, 161,  95,  95,
+     95,  95,  95,  95,  95,  95,  96,  96, 160, 160, 160, 160, 160, 160, 160, 160,
+    160, 160,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97, 159, 159, 158, 158,
+    158, 158, 158, 158, 158, 158, 158,  98,  98,  98,  99,  99,  99,  99,  99,  99,
+     99, 157, 157, 157, 157, 157, 156, 156, 156, 156, 156, 100, 100, 100, 100, 100,
+    100, 100, 101, 101, 101, 155, 155, 155, 155, 155, 155, 155, 155, 155, 154, 102,
+    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 103, 103, 104, 104, 104, 104, 104, 104, 104, 104, 152, 152,
+    152, 152, 151, 151, 151, 151, 151, 151, 105, 105, 105, 105, 105, 105, 106, 106,
+    106, 106, 150, 150, 150, 150, 150, 150, 150, 150, 149, 149, 149, 107, 107, 107,
+    107, 107, 107, 107, 107, 107, 108, 148, 148, 148, 148, 148, 148, 148, 148, 148,
+    148, 108, 109, 109, 109, 109, 109, 109, 109, 109, 109, 147, 147, 147, 146, 146,
+    146, 146, 146, 146, 146, 110, 110, 110, 110, 110, 111, 111, 111, 111, 111, 111,
+    145, 145, 145, 145, 145, 145, 144, 144, 144, 144, 112, 112, 112, 112, 112, 112,
+    112, 112, 113, 113, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 114, 114,
+    114, 114, 114, 114, 114, 114, 114, 114, 114, 142, 141, 141, 141, 141, 141, 141,
+    141, 141, 141, 115, 115, 115, 116, 116, 116, 116, 116, 116, 116, 140, 140, 140,
+    140, 140, 139, 139, 139, 139, 139, 117, 117, 117, 117, 117, 117, 117, 118, 118,
+    118, 138, 138, 138, 138, 138, 138, 138, 138, 138, 137, 137, 119, 119, 119, 119,
+    119, 119, 119, 119, 119, 119, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136,
+    120, 120, 121, 121, 121, 121, 121, 121, 121, 121, 135, 135, 135, 135, 134, 134,
+    134, 134, 134, 134, 122, 122, 122, 122, 122, 122, 123, 123, 123, 123, 123, 133,
+    133, 133, 133, 133, 133, 133, 132, 132, 132, 124, 124, 124, 124, 124, 124, 124,
+    124, 124, 125, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 125, 126, 126,
+    126, 126, 126, 126, 126, 126, 126, 130, 130, 130, 129, 129, 129, 129, 129, 129,
+    129, 129, 127, 127, 127, 127, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 188, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 186,  70,
+     70,  70,  70,  70,  70,  70,  70,  70,  70,  70,  71,  71,  71, 185, 185, 185,
+    185, 185, 185, 185, 185, 185, 184, 184, 184, 184,  72,  72,  72,  72,  72,  72,
+     72,  72,  73,  73,  73,  73,  73,  73, 183, 183, 183, 183, 183, 183, 182, 182,
+    182, 182, 182, 182, 182, 182,  74,  74,  74,  74,  75,  75,  75,  75,  75,  75,
+     75,  75,  75, 181, 181, 181, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+    180,  76,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77, 178, 178,
+    178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 177, 177,  79,  79,  79,  79,
+     79,  79,  79,  79,  79,  79,  80,  80,  80,  80, 176, 176, 176, 176, 176, 176,
+    176, 176, 175, 175, 175, 175, 175,  81,  81,  81,  81,  81,  81,  81,  82,  82,
+     82,  82,  82,  82,  82, 174, 174, 174, 174, 174, 173, 173, 173, 173, 173, 173,
+    173, 173,  83,  83,  83,  83,  84,  84,  84,  84,  84,  84,  84,  84,  84,  84,
+    172, 172, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171,  86,  86,
+     86,  86,  86,  86,  86,  86,  86,  86,  86,  86,  87, 169, 169, 169, 169, 169,
+    169, 169, 169, 169, 169, 169, 168, 168, 168,  88,  88,  88,  88,  88,  88,  88,
+     88,  88,  89,  89,  89,  89, 167, 167, 167, 167, 167, 167, 167, 167, 166, 166,
+    166, 166, 166, 166,  90,  90,  90,  90,  90,  90,  91,  91,  91,  91,  91,  91,
+     91,  91, 165, 165, 165, 165, 164, 164, 164, 164, 164, 164, 164, 164, 164,  92,
+     92,  92,  93,  93,  93,  93,  93,  93,  93,  93,  93,  93,  93, 163, 162, 162,
+    162, 162, 162, 162, 162, 162, 162, 162, 162, 162,  95,  95,  95,  95,  95,  95,
+     95,  95,  95,  95,  95,  95,  96,  96, 160, 160, 160, 160, 160, 160, 160, 160,
+    160, 160, 159, 159, 159, 159,  97,  97,  97,  97,  97,  97,  97,  97,  98,  98,
+     98,  98,  98, 158, 158, 158, 158, 158, 158, 158, 157, 157, 157, 157, 157, 157,
+    157,  99,  99,  99,  99,  99, 100, 100, 100, 100, 100, 100, 100, 100, 156, 156,
+    156, 156, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 101, 101, 102, 102,
+    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 152, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+    104, 104, 105, 105, 105, 151, 151, 151, 151, 151, 151, 151, 151, 151, 150, 150,
+    150, 150, 106, 106, 106, 106, 106, 106, 106, 106, 107, 107, 107, 107, 107, 107,
+    149, 149, 149, 149, 149, 149, 148, 148, 148, 148, 148, 148, 148, 148, 108, 108,
+    108, 108, 109, 109, 109, 109, 109, 109, 109, 109, 109, 147, 147, 147, 146, 146,
+    146, 146, 146, 146, 146, 146, 146, 146, 146, 110, 111, 111, 111, 111, 111, 111,
+    111, 111, 111, 111, 111, 111, 112, 144, 144, 144, 144, 144, 144, 144, 144, 144,
+    144, 144, 143, 143, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 114, 114,
+    114, 114, 142, 142, 142, 142, 142, 142, 142, 142, 141, 141, 141, 141, 141, 115,
+    115, 115, 115, 115, 115, 115, 116, 116, 116, 116, 116, 116, 116, 140, 140, 140,
+    140, 140, 139, 139, 139, 139, 139, 139, 139, 139, 139, 117, 117, 117, 118, 118,
+    118, 118, 118, 118, 118, 118, 118, 118, 138, 138, 137, 137, 137, 137, 137, 137,
+    137, 137, 137, 137, 137, 137, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120,
+    120, 120, 121, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 134, 134,
+    134, 122, 122, 122, 122, 122, 122, 122, 122, 122, 123, 123, 123, 123, 123, 133,
+    133, 133, 133, 133, 133, 133, 132, 132, 132, 132, 132, 132, 124, 124, 124, 124,
+    124, 124, 125, 125, 125, 125, 125, 125, 125, 125, 131, 131, 131, 131, 130, 130,
+    130, 130, 130, 130, 130, 130, 130, 126, 126, 126, 127, 127, 127, 127, 127, 127,
+    127, 127, 127, 127, 127, 129, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 188, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+    187, 187, 187, 187, 187, 187,  70,  70,  70,  70,  70,  70,  70,  70,  70,  70,
+     70,  70,  70,  70,  70,  70,  70,  70,  70,  70, 185, 185, 185, 185, 185, 185,
+    185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 184,  72,
+     72,  72,  72,  72,  72,  72,  72,  72,  72,  72,  72,  72,  72,  72,  72,  72,
+     72,  72,  73, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183,
+    183, 183, 183, 183, 183, 183, 182, 182,  74,  74,  74,  74,  74,  74,  74,  74,
+     74,  74,  74,  74,  74,  74,  74,  74,  74,  74,  75,  75, 181, 181, 181, 181,
+    181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 180, 180,
+     76,  76,  76,  76,  76,  76,  76,  76,  76,  76,  76,  76,  76,  76,  76,  76,
+     76,  76,  77,  77,  77, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+    179, 179, 179, 179, 179, 179, 178, 178, 178,  78,  78,  78,  78,  78,  78,  78,
+     78,  78,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79,  79,  79, 177, 177,
+    177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 176, 176,
+    176, 176,  80,  80,  80,  80,  80,  80,  80,  80,  80,  80,  80,  80,  80,  80,
+     80,  80,  81,  81,  81,  81, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175,
+    175, 175, 175, 175, 175, 175, 174, 174, 174, 174, 174,  82,  82,  82,  82,  82,
+     82,  82,  82,  82,  82,  82,  82,  82,  82,  82,  83,  83,  83,  83,  83, 173,
+    173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 172, 172,
+    172, 172, 172, 172,  84,  84,  84,  84,  84,  84,  84,  84,  84,  84,  84,  84,
+     84,  84,  85,  85,  85,  85,  85,  85, 171, 171, 171, 171, 171, 171, 171, 171,
+    171, 171, 171, 171, 171, 171, 170, 170, 170, 170, 170, 170,  86,  86,  86,  86,
+     86,  86,  86,  86,  86,  86,  86,  86,  86,  86,  87,  87,  87,  87,  87,  87,
+     87, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 168, 168,
+    168, 168, 168, 168, 168,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,
+     88,  88,  89,  89,  89,  89,  89,  89,  89,  89, 167, 167, 167, 167, 167, 167,
+    167, 167, 167, 167, 167, 167, 166, 166, 166, 166, 166, 166, 166, 166,  90,  90,
+     90,  90,  90,  90,  90,  90,  90,  90,  90,  90,  91,  91,  91,  91,  91,  91,
+     91,  91, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 164, 164,
+    164, 164, 164, 164, 164, 164, 164,  92,  92,  92,  92,  92,  92,  92,  92,  92,
+     92,  92,  93,  93,  93,  93,  93,  93,  93,  93,  93, 163, 163, 163, 163, 163,
+    163, 163, 163, 163, 163, 163, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162,
+     94,  94,  94,  94,  94,  94,  94,  94,  94,  94,  95,  95,  95,  95,  95,  95,
+     95,  95,  95,  95, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 160, 160,
+    160, 160, 160, 160, 160, 160, 160, 160, 160,  96,  96,  96,  96,  96,  96,  96,
+     96,  96,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97, 159, 159, 159,
+    159, 159, 159, 159, 159, 159, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158,
+    158,  98,  98,  98,  98,  98,  98,  98,  98,  98,  99,  99,  99,  99,  99,  99,
+     99,  99,  99,  99,  99,  99, 157, 157, 157, 157, 157, 157, 157, 157, 156, 156,
+    156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 100, 100, 100, 100, 100, 100,
+    100, 100, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 155,
+    155, 155, 155, 155, 155, 155, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+    154, 154, 154, 102, 102, 102, 102, 102, 102, 102, 103, 103, 103, 103, 103, 103,
+    103, 103, 103, 103, 103, 103, 103, 153, 153, 153, 153, 153, 153, 153, 152, 152,
+    152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 104, 104, 104, 104,
+    104, 104, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105,
+    151, 151, 151, 151, 151, 151, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150,
+    150, 150, 150, 150, 150, 106, 106, 106, 106, 106, 107, 107, 107, 107, 107, 107,
+    107, 107, 107, 107, 107, 107, 107, 107, 107, 149, 149, 149, 149, 149, 148, 148,
+    148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 108, 108, 108,
+    108, 108, 109, 109, 109, 109, 109, 109, 109, 109, 109, 109, 109, 109, 109, 109,
+    109, 109, 147, 147, 147, 147, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146,
+    146, 146, 146, 146, 146, 146, 110, 110, 110, 110, 111, 111, 111, 111, 111, 111,
+    111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 145, 145, 145, 144, 144,
+    144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 112,
+    112, 112, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113, 113,
+    113, 113, 113, 143, 143, 143, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142,
+    142, 142, 142, 142, 142, 142, 142, 142, 114, 114, 115, 115, 115, 115, 115, 115,
+    115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 141, 141, 140, 140,
+    140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140,
+    140, 116, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117,
+    117, 117, 117, 117, 117, 139, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138,
+    138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 119, 119, 119, 119, 119, 119,
+    119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 136, 136,
+    136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136,
+    136, 136, 121, 121, 121, 121, 121, 121, 121, 121, 121, 121, 121, 121, 121, 121,
+    121, 121, 121, 121, 121, 121, 122, 134, 134, 134, 134, 134, 134, 134, 134, 134,
+    134, 134, 134, 134, 134, 134, 134, 134, 134, 134, 133, 123, 123, 123, 123, 123,
+    123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 124, 124,
+    132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
+    132, 132, 131, 131, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125,
+    125, 125, 125, 125, 125, 125, 126, 126, 130, 130, 130, 130, 130, 130, 130, 130,
+    130, 130, 130, 130, 130, 130, 130, 130, 130, 130, 129, 129, 129, 127, 127, 127,
+    127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128,
+};
+
+static const uint8_t winSamples[5523] = {
+    128, 188, 187, 187, 187, 187, 187, 187, 187,  69,  69,  69,  69,  69,  69,  69,
+     70, 186, 186, 186, 186, 186, 186, 186,  70,  70,  70,  70,  70,  70,  70,  71,
+    185, 185, 185, 185, 185, 185, 185, 185,  71,  71,  71,  71,  71,  71,  72, 184,
+    184, 184, 184, 184, 184, 184, 184,  72,  72,  72,  72,  72,  73,  73,  73, 183,
+    183, 183, 183, 183, 183, 183,  73,  73,  73,  73,  73,  74,  74,  74, 182, 182,
+    182, 182, 182, 182, 182, 182,  74,  74,  74,  74,  75,  75,  75, 181, 181, 181,
+    181, 181, 181, 181, 181,  75,  75,  75,  76,  76,  76,  76,  76, 180, 180, 180,
+    180, 180, 180, 180,  76,  76,  76,  77,  77,  77,  77,  77, 179, 179, 179, 179,
+    179, 179, 179, 179,  77,  77,  78,  78,  78,  78,  78, 178, 178, 178, 178, 178,
+    178, 178, 178,  78,  79,  79,  79,  79,  79,  79, 177, 177, 177, 177, 177, 177,
+    177, 177,  79,  80,  80,  80,  80,  80,  80,  80, 176, 176, 176, 176, 176, 176,
+    176,  80,  81,  81,  81,  81,  81,  81,  81, 175, 175, 175, 175, 175, 175, 175,
+    174,  82,  82,  82,  82,  82,  82,  82, 174, 174, 174, 174, 174, 174, 174, 173,
+     83,  83,  83,  83,  83,  83,  83,  83, 173, 173, 173, 173, 173, 173, 172,  84,
+     84,  84,  84,  84,  84,  84,  84, 172, 172, 172, 172, 172, 171, 171, 171,  85,
+     85,  85,  85,  85,  85,  85, 171, 171, 171, 171, 171, 170, 170, 170,  86,  86,
+     86,  86,  86,  86,  86,  86, 170, 170, 170, 170, 169, 169, 169,  87,  87,  87,
+     87,  87,  87,  87,  87, 169, 169, 169, 168, 168, 168, 168,  88,  88,  88,  88,
+     88,  88,  88,  88, 168, 168, 168, 167, 167, 167, 167, 167,  89,  89,  89,  89,
+     89,  89,  89, 167, 167, 167, 166, 166, 166, 166, 166,  90,  90,  90,  90,  90,
+     90,  90,  90, 166, 165, 165, 165, 165, 165, 165,  91,  91,  91,  91,  91,  91,
+     91,  91, 165, 164, 164, 164, 164, 164, 164, 164,  92,  92,  92,  92,  92,  92,
+     92, 164, 163, 163, 163, 163, 163, 163, 163,  93,  93,  93,  93,  93,  93,  93,
+     94, 162, 162, 162, 162, 162, 162, 162,  94,  94,  94,  94,  94,  94,  94,  95,
+    161, 161, 161, 161, 161, 161, 161, 161,  95,  95,  95,  95,  95,  95,  96, 160,
+    160, 160, 160, 160, 160, 160, 160,  96,  96,  96,  96,  96,  97,  97,  97, 159,
+    159, 159, 159, 159, 159, 159,  97,  97,  97,  97,  97,  98,  98,  98, 158, 158,
+    158, 158, 158, 158, 158,  98,  98,  98,  98,  98,  99,  99,  99, 157, 157, 157,
+    157, 157, 157, 157, 157,  99,  99,  99, 100, 100, 100, 100, 156, 156, 156, 156,
+    156, 156, 156, 156, 100, 100, 100, 101, 101, 101, 101, 101, 155, 155, 155, 155,
+    155, 155, 155, 101, 101, 101, 102, 102, 102, 102, 102, 154, 154, 154, 154, 154,
+    154, 154, 154, 102, 103, 103, 103, 103, 103, 103, 153, 153, 153, 153, 153, 153,
+    153, 153, 103, 104, 104, 104, 104, 104, 104, 104, 152, 152, 152, 152, 152, 152,
+    152, 104, 105, 105, 105, 105, 105, 105, 105, 151, 151, 151, 151, 151, 151, 151,
+    150, 106, 106, 106, 106, 106, 106, 106, 150, 150, 150, 150, 150, 150, 150, 149,
+    107, 107, 107, 107, 107, 107, 107, 149, 149, 149, 149, 149, 149, 149, 148, 108,
+    108, 108, 108, 108, 108, 108, 108, 148, 148, 148, 148, 148, 147, 147, 109, 109,
+    109, 109, 109, 109, 109, 109, 147, 147, 147, 147, 147, 146, 146, 146, 110, 110,
+    110, 110, 110, 110, 110, 146, 146, 146, 146, 146, 145, 145, 145, 111, 111, 111,
+    111, 111, 111, 111, 111, 145, 145, 145, 144, 144, 144, 144, 112, 112, 112, 112,
+    112, 112, 112, 112, 144, 144, 144, 143, 143, 143, 143, 143, 113, 113, 113, 113,
+    113, 113, 113, 143, 143, 143, 142, 142, 142, 142, 142, 114, 114, 114, 114, 114,
+    114, 114, 114, 142, 141, 141, 141, 141, 141, 141, 115, 115, 115, 115, 115, 115,
+    115, 115, 141, 140, 140, 140, 140, 140, 140, 116, 116, 116, 116, 116, 116, 116,
+    116, 140, 139, 139, 139, 139, 139, 139, 139, 117, 117, 117, 117, 117, 117, 117,
+    138, 138, 138, 138, 138, 138, 138, 138, 118, 118, 118, 118, 118, 118, 118, 119,
+    137, 137, 137, 137, 137, 137, 137, 119, 119, 119, 119, 119, 119, 119, 120, 136,
+    136, 136, 136, 136, 136, 136, 136, 120, 120, 120, 120, 120, 121, 121, 135, 135,
+    135, 135, 135, 135, 135, 135, 121, 121, 121, 121, 121, 122, 122, 122, 134, 134,
+    134, 134, 134, 134, 134, 122, 122, 122, 122, 122, 123, 123, 123, 133, 133, 133,
+    133, 133, 133, 133, 133, 123, 123, 123, 124, 124, 124, 124, 132, 132, 132, 132,
+    132, 132, 132, 132, 124, 124, 124, 125, 125, 125, 125, 125, 131, 131, 131, 131,
+    131, 131, 131, 125, 125, 125, 126, 126, 126, 126, 126, 130, 130, 130, 130, 130,
+    130, 130, 126, 126, 127, 127, 127, 127, 127, 127, 129, 129, 129, 129, 129, 129,
+    129, 129, 127, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 188, 187, 187, 187, 187, 187, 187,  69,  69,  69,  69,  69,  69, 187, 187,
+    186, 186, 186, 186,  70,  70,  70,  70,  70,  70, 186, 186, 186, 186, 186, 185,
+     71,  71,  71,  71,  71,  71, 185, 185, 185, 185, 185, 185,  71,  71,  72,  72,
+     72,  72, 184, 184, 184, 184, 184, 184,  72,  72,  72,  72,  73,  73, 183, 183,
+    183, 183, 183, 183,  73,  73,  73,  73,  73,  73, 183, 182, 182, 182, 182, 182,
+     74,  74,  74,  74,  74,  74, 182, 182, 182, 182, 181, 181, 181,  75,  75,  75,
+     75,  75,  75, 181, 181, 181, 181, 181, 180,  76,  76,  76,  76,  76,  76, 180,
+    180, 180, 180, 180, 180,  76,  76,  77,  77,  77,  77, 179, 179, 179, 179, 179,
+    179,  77,  77,  77,  77,  77,  78, 178, 178, 178, 178, 178, 178,  78,  78,  78,
+     78,  78,  78, 178, 177, 177, 177, 177, 177,  79,  79,  79,  79,  79,  79, 177,
+    177, 177, 177, 176, 176,  80,  80,  80,  80,  80,  80, 176, 176, 176, 176, 176,
+    176, 176,  81,  81,  81,  81,  81,  81, 175, 175, 175, 175, 175, 175,  81,  81,
+     82,  82,  82,  82, 174, 174, 174, 174, 174, 174,  82,  82,  82,  82,  82,  83,
+    173, 173, 173, 173, 173, 173,  83,  83,  83,  83,  83,  83, 173, 173, 172, 172,
+    172, 172,  84,  84,  84,  84,  84,  84, 172, 172, 172, 172, 171, 171,  85,  85,
+     85,  85,  85,  85, 171, 171, 171, 171, 171, 171,  85,  86,  86,  86,  86,  86,
+    170, 170, 170, 170, 170, 170, 170,  86,  86,  86,  87,  87,  87, 169, 169, 169,
+    169, 169, 169,  87,  87,  87,  87,  87,  88, 168, 168, 168, 168, 168, 168,  88,
+     88,  88,  88,  88,  88, 168, 168, 167, 167, 167, 167,  89,  89,  89,  89,  89,
+     89, 167, 167, 167, 167, 167, 166,  90,  90,  90,  90,  90,  90, 166, 166, 166,
+    166, 166, 166,  90,  91,  91,  91,  91,  91, 165, 165, 165, 165, 165, 165,  91,
+     91,  91,  91,  92,  92, 164, 164, 164, 164, 164, 164,  92,  92,  92,  92,  92,
+     92,  92, 163, 163, 163, 163, 163, 163,  93,  93,  93,  93,  93,  93, 163, 163,
+    162, 162, 162, 162,  94,  94,  94,  94,  94,  94, 162, 162, 162, 162, 162, 161,
+     95,  95,  95,  95,  95,  95, 161, 161, 161, 161, 161, 161,  95,  95,  96,  96,
+     96,  96, 160, 160, 160, 160, 160, 160,  96,  96,  96,  96,  97,  97, 159, 159,
+    159, 159, 159, 159,  97,  97,  97,  97,  97,  97, 159, 158, 158, 158, 158, 158,
+     98,  98,  98,  98,  98,  98,  98, 158, 158, 158, 157, 157, 157,  99,  99,  99,
+     99,  99,  99, 157, 157, 157, 157, 157, 156, 100, 100, 100, 100, 100, 100, 156,
+    156, 156, 156, 156, 156, 100, 100, 101, 101, 101, 101, 155, 155, 155, 155, 155,
+    155, 101, 101, 101, 101, 101, 102, 154, 154, 154, 154, 154, 154, 102, 102, 102,
+    102, 102, 102, 154, 153, 153, 153, 153, 153, 103, 103, 103, 103, 103, 103, 153,
+    153, 153, 153, 152, 152, 104, 104, 104, 104, 104, 104, 104, 152, 152, 152, 152,
+    152, 152, 105, 105, 105, 105, 105, 105, 151, 151, 151, 151, 151, 151, 105, 105,
+    106, 106, 106, 106, 150, 150, 150, 150, 150, 150, 106, 106, 106, 106, 106, 107,
+    149, 149, 149, 149, 149, 149, 107, 107, 107, 107, 107, 107, 149, 149, 148, 148,
+    148, 148, 108, 108, 108, 108, 108, 108, 148, 148, 148, 148, 147, 147, 109, 109,
+    109, 109, 109, 109, 147, 147, 147, 147, 147, 147, 109, 110, 110, 110, 110, 110,
+    146, 146, 146, 146, 146, 146, 146, 110, 110, 110, 111, 111, 111, 145, 145, 145,
+    145, 145, 145, 111, 111, 111, 111, 111, 112, 144, 144, 144, 144, 144, 144, 112,
+    112, 112, 112, 112, 112, 144, 144, 143, 143, 143, 143, 113, 113, 113, 113, 113,
+    113, 143, 143, 143, 143, 143, 142, 114, 114, 114, 114, 114, 114, 142, 142, 142,
+    142, 142, 142, 114, 115, 115, 115, 115, 115, 141, 141, 141, 141, 141, 141, 115,
+    115, 115, 115, 116, 116, 140, 140, 140, 140, 140, 140, 140, 116, 116, 116, 116,
+    116, 116, 139, 139, 139, 139, 139, 139, 117, 117, 117, 117, 117, 117, 139, 139,
+    138, 138, 138, 138, 118, 118, 118, 118, 118, 118, 138, 138, 138, 138, 138, 137,
+    119, 119, 119, 119, 119, 119, 137, 137, 137, 137, 137, 137, 119, 119, 120, 120,
+    120, 120, 136, 136, 136, 136, 136, 136, 120, 120, 120, 120, 121, 121, 135, 135,
+    135, 135, 135, 135, 121, 121, 121, 121, 121, 121, 135, 134, 134, 134, 134, 134,
+    134, 122, 122, 122, 122, 122, 122, 134, 134, 134, 133, 133, 133, 123, 123, 123,
+    123, 123, 123, 133, 133, 133, 133, 133, 132, 124, 124, 124, 124, 124, 124, 132,
+    132, 132, 132, 132, 132, 124, 124, 125, 125, 125, 125, 131, 131, 131, 131, 131,
+    131, 125, 125, 125, 125, 125, 126, 130, 130, 130, 130, 130, 130, 126, 126, 126,
+    126, 126, 126, 130, 129, 129, 129, 129, 129, 127, 127, 127, 127, 127, 127, 129,
+    129, 129, 129, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 188, 187, 187, 187, 187, 187,  69,  69,  69,  69,  69, 187, 187, 187, 187,
+    186,  70,  70,  70,  70,  70, 186, 186, 186, 186, 186,  70,  70,  70,  70,  71,
+    185, 185, 185, 185, 185,  71,  71,  71,  71,  71, 185, 185, 185, 185, 184,  72,
+     72,  72,  72,  72,  72, 184, 184, 184, 184, 184,  72,  72,  73,  73,  73, 183,
+    183, 183, 183, 183,  73,  73,  73,  73,  73, 183, 183, 182, 182, 182,  74,  74,
+     74,  74,  74, 182, 182, 182, 182, 182,  74,  74,  75,  75,  75, 181, 181, 181,
+    181, 181,  75,  75,  75,  75,  75,  75, 180, 180, 180, 180, 180,  76,  76,  76,
+     76,  76, 180, 180, 180, 180, 180,  77,  77,  77,  77,  77, 179, 179, 179, 179,
+    179,  77,  77,  77,  77,  77, 178, 178, 178, 178, 178,  78,  78,  78,  78,  78,
+    178, 178, 178, 178, 177,  79,  79,  79,  79,  79,  79, 177, 177, 177, 177, 177,
+     79,  79,  79,  80,  80, 176, 176, 176, 176, 176,  80,  80,  80,  80,  80, 176,
+    176, 176, 175, 175,  81,  81,  81,  81,  81, 175, 175, 175, 175, 175,  81,  81,
+     82,  82,  82, 174, 174, 174, 174, 174,  82,  82,  82,  82,  82,  82, 174, 173,
+    173, 173, 173,  83,  83,  83,  83,  83, 173, 173, 173, 173, 173,  83,  84,  84,
+     84,  84, 172, 172, 172, 172, 172,  84,  84,  84,  84,  84, 171, 171, 171, 171,
+    171,  85,  85,  85,  85,  85, 171, 171, 171, 171, 171, 170,  86,  86,  86,  86,
+     86, 170, 170, 170, 170, 170,  86,  86,  86,  86,  87, 169, 169, 169, 169, 169,
+     87,  87,  87,  87,  87, 169, 169, 169, 168, 168,  88,  88,  88,  88,  88, 168,
+    168, 168, 168, 168,  88,  88,  88,  89,  89, 167, 167, 167, 167, 167, 167,  89,
+     89,  89,  89,  89, 167, 167, 166, 166, 166,  90,  90,  90,  90,  90, 166, 166,
+    166, 166, 166,  90,  91,  91,  91,  91, 165, 165, 165, 165, 165,  91,  91,  91,
+     91,  91, 165, 164, 164, 164, 164,  92,  92,  92,  92,  92, 164, 164, 164, 164,
+    164, 164,  93,  93,  93,  93,  93, 163, 163, 163, 163, 163,  93,  93,  93,  93,
+     94, 162, 162, 162, 162, 162,  94,  94,  94,  94,  94, 162, 162, 162, 162, 161,
+     95,  95,  95,  95,  95, 161, 161, 161, 161, 161,  95,  95,  95,  95,  96, 160,
+    160, 160, 160, 160, 160,  96,  96,  96,  96,  96, 160, 160, 159, 159, 159,  97,
+     97,  97,  97,  97, 159, 159, 159, 159, 159,  97,  97,  98,  98,  98, 158, 158,
+    158, 158, 158,  98,  98,  98,  98,  98, 158, 158, 157, 157, 157,  99,  99,  99,
+     99,  99, 157, 157, 157, 157, 157, 157, 100, 100, 100, 100, 100, 156, 156, 156,
+    156, 156, 100, 100, 100, 100, 100, 155, 155, 155, 155, 155, 101, 101, 101, 101,
+    101, 155, 155, 155, 155, 155, 102, 102, 102, 102, 102, 154, 154, 154, 154, 154,
+    102, 102, 102, 102, 103, 103, 153, 153, 153, 153, 153, 103, 103, 103, 103, 103,
+    153, 153, 153, 152, 152, 104, 104, 104, 104, 104, 152, 152, 152, 152, 152, 104,
+    104, 104, 105, 105, 151, 151, 151, 151, 151, 105, 105, 105, 105, 105, 151, 151,
+    150, 150, 150, 106, 106, 106, 106, 106, 106, 150, 150, 150, 150, 150, 106, 107,
+    107, 107, 107, 149, 149, 149, 149, 149, 107, 107, 107, 107, 107, 149, 148, 148,
+    148, 148, 108, 108, 108, 108, 108, 148, 148, 148, 148, 148, 109, 109, 109, 109,
+    109, 147, 147, 147, 147, 147, 109, 109, 109, 109, 109, 110, 146, 146, 146, 146,
+    146, 110, 110, 110, 110, 110, 146, 146, 146, 146, 145, 111, 111, 111, 111, 111,
+    145, 145, 145, 145, 145, 111, 111, 111, 112, 112, 144, 144, 144, 144, 144, 112,
+    112, 112, 112, 112, 144, 144, 144, 143, 143, 113, 113, 113, 113, 113, 113, 143,
+    143, 143, 143, 143, 113, 113, 114, 114, 114, 142, 142, 142, 142, 142, 114, 114,
+    114, 114, 114, 142, 141, 141, 141, 141, 115, 115, 115, 115, 115, 141, 141, 141,
+    141, 141, 115, 116, 116, 116, 116, 140, 140, 140, 140, 140, 116, 116, 116, 116,
+    116, 116, 139, 139, 139, 139, 139, 117, 117, 117, 117, 117, 139, 139, 139, 139,
+    138, 118, 118, 118, 118, 118, 138, 138, 138, 138, 138, 118, 118, 118, 118, 119,
+    137, 137, 137, 137, 137, 119, 119, 119, 119, 119, 137, 137, 137, 137, 136, 136,
+    120, 120, 120, 120, 120, 136, 136, 136, 136, 136, 120, 120, 121, 121, 121, 135,
+    135, 135, 135, 135, 121, 121, 121, 121, 121, 135, 135, 134, 134, 134, 122, 122,
+    122, 122, 122, 134, 134, 134, 134, 134, 122, 122, 123, 123, 123, 133, 133, 133,
+    133, 133, 133, 123, 123, 123, 123, 123, 132, 132, 132, 132, 132, 124, 124, 124,
+    124, 124, 132, 132, 132, 132, 132, 125, 125, 125, 125, 125, 131, 131, 131, 131,
+    131, 125, 125, 125, 125, 125, 130, 130, 130, 130, 130, 126, 126, 126, 126, 126,
+    130, 130, 130, 130, 129, 129, 127, 127, 127, 127, 127, 129, 129, 129, 129, 129,
+    127, 127, 127, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 188, 187, 187, 187,  69,  69,  69,  69, 187, 187, 187, 187,  69,  69,  69,
+     69, 187, 187, 187, 187,  69,  69,  69, 187, 187, 187, 187,  69,  69,  69,  69,
+    187, 187, 187, 187,  69,  69,  69,  69, 187, 187, 186, 186,  70,  70,  70, 186,
+    186, 186, 186,  70,  70,  70,  70, 186, 186, 186, 186,  70,  70,  70,  70, 186,
+    186, 186,  70,  70,  70,  70, 186, 186, 186, 186,  70,  70,  70,  70, 186, 186,
+    186, 186,  71,  71,  71,  71, 185, 185, 185,  71,  71,  71,  71, 185, 185, 185,
+    185,  71,  71,  71,  71, 185, 185, 185, 185,  71,  71,  71, 185, 185, 185, 185,
+     71,  71,  71,  71, 185, 185, 185, 185,  71,  71,  72,  72, 184, 184, 184, 184,
+     72,  72,  72, 184, 184, 184, 184,  72,  72,  72,  72, 184, 184, 184, 184,  72,
+     72,  72,  72, 184, 184, 184,  72,  72,  72,  72, 184, 184, 184, 184,  72,  72,
+     72,  72, 183, 183, 183, 183,  73,  73,  73,  73, 183, 183, 183,  73,  73,  73,
+     73, 183, 183, 183, 183,  73,  73,  73,  73, 183, 183, 183, 183,  73,  73,  73,
+     73, 183, 183, 183,  73,  73,  73,  73, 183, 183, 182, 182,  74,  74,  74,  74,
+    182, 182, 182, 182,  74,  74,  74, 182, 182, 182, 182,  74,  74,  74,  74, 182,
+    182, 182, 182,  74,  74,  74,  74, 182, 182, 182, 182,  74,  74,  74, 182, 182,
+    182, 182,  75,  75,  75,  75, 181, 181, 181, 181,  75,  75,  75,  75, 181, 181,
+    181,  75,  75,  75,  75, 181, 181, 181, 181,  75,  75,  75,  75, 181, 181, 181,
+    181,  75,  75,  75,  75, 181, 181, 181,  75,  75,  76,  76, 180, 180, 180, 180,
+     76,  76,  76,  76, 180, 180, 180, 180,  76,  76,  76, 180, 180, 180, 180,  76,
+     76,  76,  76, 180, 180, 180, 180,  76,  76,  76,  76, 180, 180, 180, 180,  76,
+     76,  76, 179, 179, 179, 179,  77,  77,  77,  77, 179, 179, 179, 179,  77,  77,
+     77,  77, 179, 179, 179, 179,  77,  77,  77, 179, 179, 179, 179,  77,  77,  77,
+     77, 179, 179, 179, 179,  77,  77,  77,  77, 179, 178, 178,  78,  78,  78,  78,
+    178, 178, 178, 178,  78,  78,  78,  78, 178, 178, 178, 178,  78,  78,  78,  78,
+    178, 178, 178,  78,  78,  78,  78, 178, 178, 178, 178,  78,  78,  78,  78, 178,
+    178, 178, 177,  79,  79,  79, 177, 177, 177, 177,  79,  79,  79,  79, 177, 177,
+    177, 177,  79,  79,  79,  79, 177, 177, 177, 177,  79,  79,  79, 177, 177, 177,
+    177,  79,  79,  79,  79, 177, 177, 177, 177,  79,  80,  80,  80, 176, 176, 176,
+     80,  80,  80,  80, 176, 176, 176, 176,  80,  80,  80,  80, 176, 176, 176, 176,
+     80,  80,  80,  80, 176, 176, 176,  80,  80,  80,  80, 176, 176, 176, 176,  80,
+     80,  80,  81, 175, 175, 175, 175,  81,  81,  81,  81, 175, 175, 175,  81,  81,
+     81,  81, 175, 175, 175, 175,  81,  81,  81,  81, 175, 175, 175, 175,  81,  81,
+     81, 175, 175, 175, 175,  81,  81,  81,  81, 175, 174, 174, 174,  82,  82,  82,
+     82, 174, 174, 174, 174,  82,  82,  82, 174, 174, 174, 174,  82,  82,  82,  82,
+    174, 174, 174, 174,  82,  82,  82,  82, 174, 174, 174,  82,  82,  82,  82, 174,
+    174, 174, 173,  83,  83,  83,  83, 173, 173, 173, 173,  83,  83,  83,  83, 173,
+    173, 173,  83,  83,  83,  83, 173, 173, 173, 173,  83,  83,  83,  83, 173, 173,
+    173, 173,  83,  83,  83, 173, 173, 173, 173,  83,  84,  84,  84, 172, 172, 172,
+    172,  84,  84,  84,  84, 172, 172, 172, 172,  84,  84,  84, 172, 172, 172, 172,
+     84,  84,  84,  84, 172, 172, 172, 172,  84,  84,  84,  84, 172, 172, 172, 172,
+     84,  84,  85, 171, 171, 171, 171,  85,  85,  85,  85, 171, 171, 171, 171,  85,
+     85,  85,  85, 171, 171, 171,  85,  85,  85,  85, 171, 171, 171, 171,  85,  85,
+     85,  85, 171, 171, 171, 171,  85,  85,  85,  85, 170, 170, 170,  86,  86,  86,
+     86, 170, 170, 170, 170,  86,  86,  86,  86, 170, 170, 170, 170,  86,  86,  86,
+    170, 170, 170, 170,  86,  86,  86,  86, 170, 170, 170, 170,  86,  86,  86,  86,
+    170, 170, 169, 169,  87,  87,  87, 169, 169, 169, 169,  87,  87,  87,  87, 169,
+    169, 169, 169,  87,  87,  87,  87, 169, 169, 169,  87,  87,  87,  87, 169, 169,
+    169, 169,  87,  87,  87,  87, 169, 169, 169, 169,  88,  88,  88,  88, 168, 168,
+    168,  88,  88,  88,  88, 168, 168, 168, 168,  88,  88,  88,  88, 168, 168, 168,
+    168,  88,  88,  88,  88, 168, 168, 168,  88,  88,  88,  88, 168, 168, 168, 168,
+     88,  88,  89,  89, 167, 167, 167, 167,  89,  89,  89, 167, 167, 167, 167,  89,
+     89,  89,  89, 167, 167, 167, 167,  89,  89,  89,  89, 167, 167, 167, 167,  89,
+     89,  89, 167, 167, 167, 167,  89,  89,  89,  89, 166, 166, 166, 166,  90,  90,
+     90,  90, 166, 166, 166,  90,  90,  90,  90, 166, 166, 166, 166,  90,  90,  90,
+     90, 166, 166, 166, 166,  90,  90,  90,  90, 166, 166, 166,  90,  90,  90,  90,
+    166, 166, 165, 165,  91,  91,  91,  91, 165, 165, 165, 165,  91,  91,  91, 165,
+    165, 165, 165,  91,  91,  91,  91, 165, 165, 165, 165,  91,  91,  91,  91, 165,
+    165, 165, 165,  91,  91,  91, 165, 165, 165, 165,  92,  92,  92,  92, 164, 164,
+    164, 164,  92,  92,  92,  92, 164, 164, 164, 164,  92,  92,  92, 164, 164, 164,
+    164,  92,  92,  92,  92, 164, 164, 164, 164,  92,  92,  92,  92, 164, 164, 164,
+     92,  92,  93,  93, 163, 163, 163, 163,  93,  93,  93,  93, 163, 163, 163, 163,
+     93,  93,  93,  93, 163, 163, 163,  93,  93,  93,  93, 163, 163, 163, 163,  93,
+     93,  93,  93, 163, 163, 163, 163,  93,  93,  93, 162, 162, 162, 162,  94,  94,
+     94,  94, 162, 162, 162, 162,  94,  94,  94,  94, 162, 162, 162, 162,  94,  94,
+     94, 162, 162, 162, 162,  94,  94,  94,  94, 162, 162, 162, 162,  94,  94,  94,
+     94, 162, 161, 161,  95,  95,  95,  95, 161, 161, 161, 161,  95,  95,  95,  95,
+    161, 161, 161, 161,  95,  95,  95,  95, 161, 161, 161,  95,  95,  95,  95, 161,
+    161, 161, 161,  95,  95,  95,  95, 161, 161, 161, 160,  96,  96,  96,  96, 160,
+    160, 160,  96,  96,  96,  96, 160, 160, 160, 160,  96,  96,  96,  96, 160, 160,
+    160, 160,  96,  96,  96, 160, 160, 160, 160,  96,  96,  96,  96, 160, 160, 160,
+    160,  96,  97,  97,  97, 159, 159, 159, 159,  97,  97,  97, 159, 159, 159, 159,
+     97,  97,  97,  97, 159, 159, 159, 159,  97,  97,  97,  97, 159, 159, 159,  97,
+     97,  97,  97, 159, 159, 159, 159,  97,  97,  97,  98, 158, 158, 158, 158,  98,
+     98,  98,  98, 158, 158, 158,  98,  98,  98,  98, 158, 158, 158, 158,  98,  98,
+     98,  98, 158, 158, 158, 158,  98,  98,  98, 158, 158, 158, 158,  98,  98,  98,
+     98, 158, 157, 157, 157,  99,  99,  99,  99, 157, 157, 157, 157,  99,  99,  99,
+    157, 157, 157, 157,  99,  99,  99,  99, 157, 157, 157, 157,  99,  99,  99,  99,
+    157, 157, 157, 157,  99,  99,  99, 157, 157, 157, 156, 100, 100, 100, 100, 156,
+    156, 156, 156, 100, 100, 100, 100, 156, 156, 156, 100, 100, 100, 100, 156, 156,
+    156, 156, 100, 100, 100, 100, 156, 156, 156, 156, 100, 100, 100, 100, 156, 156,
+    156, 100, 101, 101, 101, 155, 155, 155, 155, 101, 101, 101, 101, 155, 155, 155,
+    155, 101, 101, 101, 155, 155, 155, 155, 101, 101, 101, 101, 155, 155, 155, 155,
+    101, 101, 101, 101, 155, 155, 155, 155, 101, 101, 102, 154, 154, 154, 154, 102,
+    102, 102, 102, 154, 154, 154, 154, 102, 102, 102, 102, 154, 154, 154, 102, 102,
+    102, 102, 154, 154, 154, 154, 102, 102, 102, 102, 154, 154, 154, 154, 102, 102,
+    102, 102, 153, 153, 153, 103, 103, 103, 103, 153, 153, 153, 153, 103, 103, 103,
+    103, 153, 153, 153, 153, 103, 103, 103, 153, 153, 153, 153, 103, 103, 103, 103,
+    153, 153, 153, 153, 103, 103, 103, 103, 153, 153, 152, 152, 104, 104, 104, 152,
+    152, 152, 152, 104, 104, 104, 104, 152, 152, 152, 152, 104, 104, 104, 104, 152,
+    152, 152, 152, 104, 104, 104, 152, 152, 152, 152, 104, 104, 104, 104, 152, 152,
+    152, 152, 105, 105, 105, 105, 151, 151, 151, 105, 105, 105, 105, 151, 151, 151,
+    151, 105, 105, 105, 105, 151, 151, 151, 151, 105, 105, 105, 105, 151, 151, 151,
+    105, 105, 105, 105, 151, 151, 151, 151, 105, 105, 106, 106, 150, 150, 150, 150,
+    106, 106, 106, 150, 150, 150, 150, 106, 106, 106, 106, 150, 150, 150, 150, 106,
+    106, 106, 106, 150, 150, 150, 150, 106, 106, 106, 150, 150, 150, 150, 106, 106,
+    106, 106, 149, 149, 149, 149, 107, 107, 107, 107, 149, 149, 149, 107, 107, 107,
+    107, 149, 149, 149, 149, 107, 107, 107, 107, 149, 149, 149, 149, 107, 107, 107,
+    107, 149, 149, 149, 107, 107, 107, 107, 149, 149, 148, 148, 108, 108, 108, 108,
+    148, 148, 148, 148, 108, 108, 108, 108, 148, 148, 148, 108, 108, 108, 108, 148,
+    148, 148, 148, 108, 108, 108, 108, 148, 148, 148, 148, 108, 108, 108, 148, 148,
+    148, 148, 109, 109, 109, 109, 147, 147, 147, 147, 109, 109, 109, 109, 147, 147,
+    147, 147, 109, 109, 109, 147, 147, 147, 147, 109, 109, 109, 109, 147, 147, 147,
+    147, 109, 109, 109, 109, 147, 147, 147, 109, 109, 110, 110, 146, 146, 146, 146,
+    110, 110, 110, 110, 146, 146, 146, 146, 110, 110, 110, 110, 146, 146, 146, 110,
+    110, 110, 110, 146, 146, 146, 146, 110, 110, 110, 110, 146, 146, 146, 146, 110,
+    110, 110, 145, 145, 145, 145, 111, 111, 111, 111, 145, 145, 145, 145, 111, 111,
+    111, 111, 145, 145, 145, 145, 111, 111, 111, 145, 145, 145, 145, 111, 111, 111,
+    111, 145, 145, 145, 145, 111, 111, 111, 111, 145, 144, 144, 144, 112, 112, 112,
+    144, 144, 144, 144, 112, 112, 112, 112, 144, 144, 144, 144, 112, 112, 112, 112,
+    144, 144, 144, 112, 112, 112, 112, 144, 144, 144, 144, 112, 112, 112, 112, 144,
+    144, 144, 143, 113, 113, 113, 113, 143, 143, 143, 113, 113, 113, 113, 143, 143,
+    143, 143, 113, 113, 113, 113, 143, 143, 143, 143, 113, 113, 113, 143, 143, 143,
+    143, 113, 113, 113, 113, 143, 143, 143, 143, 113, 114, 114, 114, 142, 142, 142,
+    142, 114, 114, 114, 142, 142, 142, 142, 114, 114, 114, 114, 142, 142, 142, 142,
+    114, 114, 114, 114, 142, 142, 142, 114, 114, 114, 114, 142, 142, 142, 142, 114,
+    114, 114, 115, 141, 141, 141, 141, 115, 115, 115, 115, 141, 141, 141, 115, 115,
+    115, 115, 141, 141, 141, 141, 115, 115, 115, 115, 141, 141, 141, 141, 115, 115,
+    115, 115, 141, 141, 141, 115, 115, 115, 115, 141, 140, 140, 140, 116, 116, 116,
+    116, 140, 140, 140, 140, 116, 116, 116, 140, 140, 140, 140, 116, 116, 116, 116,
+    140, 140, 140, 140, 116, 116, 116, 116, 140, 140, 140, 140, 116, 116, 116, 140,
+    140, 140, 139, 117, 117, 117, 117, 139, 139, 139, 139, 117, 117, 117, 117, 139,
+    139, 139, 117, 117, 117, 117, 139, 139, 139, 139, 117, 117, 117, 117, 139, 139,
+    139, 139, 117, 117, 117, 117, 139, 139, 139, 117, 118, 118, 118, 138, 138, 138,
+    138, 118, 118, 118, 118, 138, 138, 138, 138, 118, 118, 118, 138, 138, 138, 138,
+    118, 118, 118, 118, 138, 138, 138, 138, 118, 118, 118, 118, 138, 138, 138, 138,
+    118, 118, 119, 137, 137, 137, 137, 119, 119, 119, 119, 137, 137, 137, 137, 119,
+    119, 119, 119, 137, 137, 137, 137, 119, 119, 119, 137, 137, 137, 137, 119, 119,
+    119, 119, 137, 137, 137, 137, 119, 119, 119, 119, 136, 136, 136, 120, 120, 120,
+    120, 136, 136, 136, 136, 120, 120, 120, 120, 136, 136, 136, 136, 120, 120, 120,
+    120, 136, 136, 136, 120, 120, 120, 120, 136, 136, 136, 136, 120, 120, 120, 120,
+    136, 136, 135, 135, 121, 121, 121, 135, 135, 135, 135, 121, 121, 121, 121, 135,
+    135, 135, 135, 121, 121, 121, 121, 135, 135, 135, 135, 121, 121, 121, 135, 135,
+    135, 135, 121, 121, 121, 121, 135, 135, 135, 135, 122, 122, 122, 122, 134, 134,
+    134, 122, 122, 122, 122, 134, 134, 134, 134, 122, 122, 122, 122, 134, 134, 134,
+    134, 122, 122, 122, 122, 134, 134, 134, 122, 122, 122, 122, 134, 134, 134, 134,
+    122, 122, 123, 123, 133, 133, 133, 133, 123, 123, 123, 123, 133, 133, 133, 123,
+    123, 123, 123, 133, 133, 133, 133, 123, 123, 123, 123, 133, 133, 133, 133, 123,
+    123, 123, 133, 133, 133, 133, 123, 123, 123, 123, 132, 132, 132, 132, 124, 124,
+    124, 124, 132, 132, 132, 132, 124, 124, 124, 132, 132, 132, 132, 124, 124, 124,
+    124, 132, 132, 132, 132, 124, 124, 124, 124, 132, 132, 132, 124, 124, 124, 124,
+    132, 132, 131, 131, 125, 125, 125, 125, 131, 131, 131, 131, 125, 125, 125, 125,
+    131, 131, 131, 125, 125, 125, 125, 131, 131, 131, 131, 125, 125, 125, 125, 131,
+    131, 131, 131, 125, 125, 125, 131, 131, 131, 131, 126, 126, 126, 126, 130, 130,
+    130, 130, 126, 126, 126, 126, 130, 130, 130, 130, 126, 126, 126, 130, 130, 130,
+    130, 126, 126, 126, 126, 130, 130, 130, 130, 126, 126, 126, 126, 130, 130, 130,
+    130, 126, 127, 127, 129, 129, 129, 129, 127, 127, 127, 127, 129, 129, 129, 129,
+    127, 127, 127, 127, 129, 129, 129, 127, 127, 127, 127, 129, 129, 129, 129, 127,
+    127, 127, 127, 129, 129, 129, 129, 127, 127, 127, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128,
+};
+
+const SoundTable soundTables[NUM_SOUNDS] = {
+    [SOUND_HIT] = { hitSamples, sizeof(hitSamples) },
+    [SOUND_MISS] = { missSamples, sizeof(missSamples) },
+    [SOUND_WIN] = { winSamples, sizeof(winSamples) },
+};
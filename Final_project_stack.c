@@ -0,0 +1,79 @@
+#include "stack.h"
+#include "stm32l476xx.h"
+
+/*=================================================================
+ * @file: stack.c
+ * @brief: Stack painting and high-water marks
+ *
+ * Layout (STM32L476RGTX_FLASH.ld), top of SRAM1 down:
+ *
+ *   _estack         handler stack (MSP), _Handler_Stack_Size
+ *   _estack_thread  thread stack (PSP), _Min_Stack_Size
+ *   _sstack_thread
+ *
+ * With one shared stack, a deep task and a deep handler could not be
+ * told apart; split, each region answers for one context.
+ *
+ * Both regions are filled with STACK_PAINT once the first frame is
+ * up, not in Reset_Handler, so the paint costs the first frame
+ * nothing. A word still holding the pattern has not been written
+ * since, so the lowest changed word of a region is its high-water
+ * mark. The boot fast path's own depth is not counted. Nothing guards
+ * the bottom: a region found overflowed means its size in the linker
+ * script is too small.
+ *===============================================================*/
+
+StackUse stackUse[NUM_STACKS];
+
+/****************************************************************************
+ * stackPaint()
+ * @parameter: None
+ * @return: None
+ * Runs in thread mode. The thread region is free below this
+ * function's own frame. The MSP does not move in thread mode, so the
+ * handler region is free below it. An interrupt taken meanwhile only
+ * leaves words under its own frames, which are finished by the time
+ * painting goes on.
+ ****************************************************************************/
+void stackPaint(void)
+{
+    uint32_t *word = &_sstack_thread;
+    uint32_t *sp = (uint32_t *)__get_PSP();
+
+    while (word < sp)
+        *word++ = STACK_PAINT;
+
+    word = &_estack_thread;
+    sp = (uint32_t *)__get_MSP();
+    while (word < sp)
+        *word++ = STACK_PAINT;
+}
+
+/****************************************************************************
+ * highWater()
+ * @parameter: bottom/top - region, use - result for it
+ * @return: None
+ * Scans up from the bottom to the first written word.
+ ****************************************************************************/
+static void highWater(const uint32_t *bottom, const uint32_t *top, StackUse *use)
+{
+    const uint32_t *word = bottom;
+
+    while (word < top && *word == STACK_PAINT)
+        word++;
+
+    use->size = (uint32_t)(top - bottom) * 4;
+    use->used = (uint32_t)(top - word) * 4;
+    use->overflowed = (word == bottom);
+}
+
+/****************************************************************************
+ * stackCheck()
+ * @parameter: None
+ * @return: None
+ ****************************************************************************/
+void stackCheck(void)
+{
+    highWater(&_sstack_thread, &_estack_thread, &stackUse[STACK_THREAD]);
+    highWater(&_estack_thread, &_estack, &stackUse[STACK_HANDLER]);
+}
@@ -0,0 +1,42 @@
+#ifndef STACK_H
+#define STACK_H
+
+/*************************************************
+ * @file: stack.h
+ *
+ * Header file for stack.c
+ * Stack high-water marks per context. Thread mode (main() and the
+ * scheduler tasks) runs on the process stack and every handler on
+ * the main stack, each in its own region of the linker script.
+ * main() paints both once the first frame is up; stackCheck() finds
+ * how deep each has been since.
+ *************************************************/
+
+#include <stdint.h>
+
+#define STACK_PAINT 0xC5C5C5C5u
+
+typedef enum {
+    STACK_THREAD,    // PSP: main(), schedRun() and the tasks
+    STACK_HANDLER,   // MSP: interrupts, the PendSV game step included
+    NUM_STACKS
+} StackId;
+
+typedef struct {
+    uint32_t size;        // bytes reserved by the linker script
+    uint32_t used;        // deepest use seen, in bytes
+    uint8_t overflowed;   // the paint at the bottom of the region is gone
+} StackUse;
+
+extern StackUse stackUse[NUM_STACKS];
+
+// Linker script symbols: handler stack on top, thread stack below it
+extern uint32_t _estack, _estack_thread, _sstack_thread;
+
+// Thread mode (PSP) only, once; main() calls it after the first frame
+void stackPaint(void);
+
+// Refreshes stackUse[]; scans at most the unused part of each region
+void stackCheck(void);
+
+#endif
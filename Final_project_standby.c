@@ -0,0 +1,102 @@
+#include "standby.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: standby.c
+ * @brief: Standby suspend and resume with retained SRAM2
+ *
+ * Standby turns off everything but the backup domain and, with
+ * PWR_CR3.RRS set, SRAM2. The image goes into a RETAINED variable
+ * there: Reset_Handler neither loads nor zeroes it, so after the wake
+ * reset it still holds what standbyEnter() wrote. A magic word and a
+ * check word tell a real image from whatever SRAM2 held at power-up.
+ *
+ * The wake pin is the user button, PC13 = WKUP2. It is pressed low,
+ * so the pin wakes on a falling edge, and its pull-up is kept through
+ * Standby by the PWR pull control (APC), since the GPIO settings are
+ * lost. The game buttons (PC0, PC1) are not wake-up pins.
+ *===============================================================*/
+
+#define STANDBY_MAGIC 0x53544259u   // "STBY"
+
+typedef struct {
+    uint32_t magic;
+    StandbyImage image;
+    uint32_t check;
+} RetainedImage;
+
+RETAINED static RetainedImage retained;
+
+/****************************************************************************
+ * imageCheck()
+ * @parameter: r - retained copy
+ * @return: check word over the magic and the image
+ ****************************************************************************/
+static uint32_t imageCheck(const RetainedImage *r)
+{
+    const uint8_t *byte = (const uint8_t *)&r->image;
+    uint32_t sum = r->magic;
+
+    for (uint8_t i = 0; i < sizeof(r->image); i++)
+        sum = (sum << 5) + (sum >> 27) + byte[i];
+    return ~sum;
+}
+
+/****************************************************************************
+ * standbyEnter()
+ * @parameter: image - game to keep
+ * @return: None (the next thing is a reset)
+ * Every interrupt is switched off and cleared first: WFI does not
+ * sleep while one is pending, even with PRIMASK set.
+ ****************************************************************************/
+void standbyEnter(const StandbyImage *image)
+{
+    __disable_irq();
+
+    retained.magic = STANDBY_MAGIC;
+    retained.image = *image;
+    retained.check = imageCheck(&retained);
+
+    SysTick->CTRL = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        NVIC->ICER[i] = 0xFFFFFFFF;
+        NVIC->ICPR[i] = 0xFFFFFFFF;
+    }
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk | SCB_ICSR_PENDSVCLR_Msk;
+
+    RCC->APB1ENR1 |= RCC_APB1ENR1_PWREN;
+    PWR->PUCRC |= PWR_PUCRC_PC13;
+    PWR->CR4 |= PWR_CR4_WP2;                    // wake on the falling edge
+    PWR->CR3 |= PWR_CR3_RRS | PWR_CR3_APC | PWR_CR3_EWUP2;
+    PWR->SCR = PWR_SCR_CWUF;                    // no stale wake-up flag
+    PWR->CR1 = (PWR->CR1 & ~PWR_CR1_LPMS) | PWR_CR1_LPMS_STANDBY;
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+
+    __DSB();
+    while (1)
+        __WFI();
+}
+
+/****************************************************************************
+ * standbyResume()
+ * @parameter: image - filled on a resume
+ * @return: 1 = woke from Standby with a good image, 0 = normal start
+ ****************************************************************************/
+int standbyResume(StandbyImage *image)
+{
+    int woke;
+
+    RCC->APB1ENR1 |= RCC_APB1ENR1_PWREN;
+    woke = (PWR->SR1 & PWR_SR1_SBF) != 0;
+
+    PWR->SCR = PWR_SCR_CSBF | PWR_SCR_CWUF;
+    PWR->CR3 &= ~PWR_CR3_APC;                   // GPIO pulls are init_Buttons()'s again
+
+    if (!woke || retained.magic != STANDBY_MAGIC || retained.check != imageCheck(&retained))
+        return 0;
+
+    *image = retained.image;
+    retained.magic = 0;
+    return 1;
+}
@@ -0,0 +1,35 @@
+#ifndef STANDBY_H
+#define STANDBY_H
+
+/*************************************************
+ * @file: standby.h
+ *
+ * Header file for standby.c
+ * Suspend to Standby with the game kept in retained SRAM2, and
+ * resume from it. The user button (PC13 = WKUP2) wakes the board;
+ * the wake is a reset, and main() puts the saved frame back before
+ * any of the slow init runs.
+ *************************************************/
+
+#include <stdint.h>
+
+#define STANDBY_IDLE_MS 60000   // no button edge this long: Standby
+
+// The game as it was when the board went to sleep
+typedef struct {
+    uint32_t speed;      // currentSpeed
+    uint8_t state;       // PongState
+    uint8_t scores;      // player 1 in bits 0-1, player 2 in bits 2-3
+    uint8_t server;      // currentServer
+    uint8_t pattern;     // ledPattern
+} StandbyImage;
+
+// Keeps image in retained SRAM2 and enters Standby; does not return
+void standbyEnter(const StandbyImage *image);
+
+// First thing in main(): 1 and image filled if this reset is a wake
+// from Standby with a good image, 0 for any other reset. The image
+// is only good once.
+int standbyResume(StandbyImage *image);
+
+#endif
@@ -0,0 +1,309 @@
+#include "stm32l476xx.h"
+#include "memmap.h"
+#include "boottime.h"
+#include "stack.h"
+
+/*=================================================================
+ * @file: startup.c
+ * @brief: Reset handler and vector table for the STM32L476
+ *
+ * Takes the place of the CubeIDE-generated startup_stm32l476rgtx.s
+ * (leave that file out of the build when this one is used). Works
+ * with STM32L476RGTX_FLASH.ld and runs the same image on the Nucleo
+ * board and on the emulated machine in emu/.
+ *
+ * Reset_Handler also fills SRAM2 with the hot game state (.sram2)
+ * and turns on the flash accelerator before main() runs. main()
+ * starts on the process stack, so thread and handler stack use can
+ * be measured apart (stack.c).
+ *
+ * Every handler the project does not define is a weak alias of
+ * Default_Handler, which spins so a stray interrupt is easy to
+ * spot in the debugger.
+ *===============================================================*/
+
+// Symbols from the linker script
+extern uint32_t _estack;
+extern uint32_t _sidata, _sdata, _edata;
+extern uint32_t _sbss, _ebss;
+extern uint32_t _sisram2, _ssram2, _esram2;
+
+int main(void);
+void Reset_Handler(void);
+void Default_Handler(void);
+
+#define RESET_HCLK 4000000   // MSI after reset
+
+#define WEAK_DEFAULT __attribute__((weak, alias("Default_Handler")))
+
+// Cortex-M4 system handlers
+void NMI_Handler(void)        WEAK_DEFAULT;
+void HardFault_Handler(void)  WEAK_DEFAULT;
+void MemManage_Handler(void)  WEAK_DEFAULT;
+void BusFault_Handler(void)   WEAK_DEFAULT;
+void UsageFault_Handler(void) WEAK_DEFAULT;
+void SVC_Handler(void)        WEAK_DEFAULT;
+void DebugMon_Handler(void)   WEAK_DEFAULT;
+void PendSV_Handler(void)     WEAK_DEFAULT;
+void SysTick_Handler(void)    WEAK_DEFAULT;
+
+// STM32L476 peripheral interrupts
+void WWDG_IRQHandler(void)               WEAK_DEFAULT;
+void PVD_PVM_IRQHandler(void)            WEAK_DEFAULT;
+void TAMP_STAMP_IRQHandler(void)         WEAK_DEFAULT;
+void RTC_WKUP_IRQHandler(void)           WEAK_DEFAULT;
+void FLASH_IRQHandler(void)              WEAK_DEFAULT;
+void RCC_IRQHandler(void)                WEAK_DEFAULT;
+void EXTI0_IRQHandler(void)              WEAK_DEFAULT;
+void EXTI1_IRQHandler(void)              WEAK_DEFAULT;
+void EXTI2_IRQHandler(void)              WEAK_DEFAULT;
+void EXTI3_IRQHandler(void)              WEAK_DEFAULT;
+void EXTI4_IRQHandler(void)              WEAK_DEFAULT;
+void DMA1_Channel1_IRQHandler(void)      WEAK_DEFAULT;
+void DMA1_Channel2_IRQHandler(void)      WEAK_DEFAULT;
+void DMA1_Channel3_IRQHandler(void)      WEAK_DEFAULT;
+void DMA1_Channel4_IRQHandler(void)      WEAK_DEFAULT;
+void DMA1_Channel5_IRQHandler(void)      WEAK_DEFAULT;
+void DMA1_Channel6_IRQHandler(void)      WEAK_DEFAULT;
+void DMA1_Channel7_IRQHandler(void)      WEAK_DEFAULT;
+void ADC1_2_IRQHandler(void)             WEAK_DEFAULT;
+void CAN1_TX_IRQHandler(void)            WEAK_DEFAULT;
+void CAN1_RX0_IRQHandler(void)           WEAK_DEFAULT;
+void CAN1_RX1_IRQHandler(void)           WEAK_DEFAULT;
+void CAN1_SCE_IRQHandler(void)           WEAK_DEFAULT;
+void EXTI9_5_IRQHandler(void)            WEAK_DEFAULT;
+void TIM1_BRK_TIM15_IRQHandler(void)     WEAK_DEFAULT;
+void TIM1_UP_TIM16_IRQHandler(void)      WEAK_DEFAULT;
+void TIM1_TRG_COM_TIM17_IRQHandler(void) WEAK_DEFAULT;
+void TIM1_CC_IRQHandler(void)            WEAK_DEFAULT;
+void TIM2_IRQHandler(void)               WEAK_DEFAULT;
+void TIM3_IRQHandler(void)               WEAK_DEFAULT;
+void TIM4_IRQHandler(void)               WEAK_DEFAULT;
+void I2C1_EV_IRQHandler(void)            WEAK_DEFAULT;
+void I2C1_ER_IRQHandler(void)            WEAK_DEFAULT;
+void I2C2_EV_IRQHandler(void)            WEAK_DEFAULT;
+void I2C2_ER_IRQHandler(void)            WEAK_DEFAULT;
+void SPI1_IRQHandler(void)               WEAK_DEFAULT;
+void SPI2_IRQHandler(void)               WEAK_DEFAULT;
+void USART1_IRQHandler(void)             WEAK_DEFAULT;
+void USART2_IRQHandler(void)             WEAK_DEFAULT;
+void USART3_IRQHandler(void)             WEAK_DEFAULT;
+void EXTI15_10_IRQHandler(void)          WEAK_DEFAULT;
+void RTC_Alarm_IRQHandler(void)          WEAK_DEFAULT;
+void DFSDM1_FLT3_IRQHandler(void)        WEAK_DEFAULT;
+void TIM8_BRK_IRQHandler(void)           WEAK_DEFAULT;
+void TIM8_UP_IRQHandler(void)            WEAK_DEFAULT;
+void TIM8_TRG_COM_IRQHandler(void)       WEAK_DEFAULT;
+void TIM8_CC_IRQHandler(void)            WEAK_DEFAULT;
+void ADC3_IRQHandler(void)               WEAK_DEFAULT;
+void FMC_IRQHandler(void)                WEAK_DEFAULT;
+void SDMMC1_IRQHandler(void)             WEAK_DEFAULT;
+void TIM5_IRQHandler(void)               WEAK_DEFAULT;
+void SPI3_IRQHandler(void)               WEAK_DEFAULT;
+void UART4_IRQHandler(void)              WEAK_DEFAULT;
+void UART5_IRQHandler(void)              WEAK_DEFAULT;
+void TIM6_DAC_IRQHandler(void)           WEAK_DEFAULT;
+void TIM7_IRQHandler(void)               WEAK_DEFAULT;
+void DMA2_Channel1_IRQHandler(void)      WEAK_DEFAULT;
+void DMA2_Channel2_IRQHandler(void)      WEAK_DEFAULT;
+void DMA2_Channel3_IRQHandler(void)      WEAK_DEFAULT;
+void DMA2_Channel4_IRQHandler(void)      WEAK_DEFAULT;
+void DMA2_Channel5_IRQHandler(void)      WEAK_DEFAULT;
+void DFSDM1_FLT0_IRQHandler(void)        WEAK_DEFAULT;
+void DFSDM1_FLT1_IRQHandler(void)        WEAK_DEFAULT;
+void DFSDM1_FLT2_IRQHandler(void)        WEAK_DEFAULT;
+void COMP_IRQHandler(void)               WEAK_DEFAULT;
+void LPTIM1_IRQHandler(void)             WEAK_DEFAULT;
+void LPTIM2_IRQHandler(void)             WEAK_DEFAULT;
+void OTG_FS_IRQHandler(void)             WEAK_DEFAULT;
+void DMA2_Channel6_IRQHandler(void)      WEAK_DEFAULT;
+void DMA2_Channel7_IRQHandler(void)      WEAK_DEFAULT;
+void LPUART1_IRQHandler(void)            WEAK_DEFAULT;
+void QUADSPI_IRQHandler(void)            WEAK_DEFAULT;
+void I2C3_EV_IRQHandler(void)            WEAK_DEFAULT;
+void I2C3_ER_IRQHandler(void)            WEAK_DEFAULT;
+void SAI1_IRQHandler(void)               WEAK_DEFAULT;
+void SAI2_IRQHandler(void)               WEAK_DEFAULT;
+void SWPMI1_IRQHandler(void)             WEAK_DEFAULT;
+void TSC_IRQHandler(void)                WEAK_DEFAULT;
+void LCD_IRQHandler(void)                WEAK_DEFAULT;
+void RNG_IRQHandler(void)                WEAK_DEFAULT;
+void FPU_IRQHandler(void)                WEAK_DEFAULT;
+
+typedef void (*VectorEntry)(void);
+
+/****************************************************************************
+ * Vector table
+ * Placed at the start of flash by the .isr_vector section.
+ ****************************************************************************/
+__attribute__((section(".isr_vector"), used))
+const VectorEntry vectorTable[] = {
+    (VectorEntry)&_estack,
+    Reset_Handler,
+    NMI_Handler,
+    HardFault_Handler,
+    MemManage_Handler,
+    BusFault_Handler,
+    UsageFault_Handler,
+    0, 0, 0, 0,
+    SVC_Handler,
+    DebugMon_Handler,
+    0,
+    PendSV_Handler,
+    SysTick_Handler,
+
+    WWDG_IRQHandler,                // 0
+    PVD_PVM_IRQHandler,
+    TAMP_STAMP_IRQHandler,
+    RTC_WKUP_IRQHandler,
+    FLASH_IRQHandler,
+    RCC_IRQHandler,
+    EXTI0_IRQHandler,               // 6: right button (PC0)
+    EXTI1_IRQHandler,               // 7: left button (PC1)
+    EXTI2_IRQHandler,
+    EXTI3_IRQHandler,
+    EXTI4_IRQHandler,               // 10
+    DMA1_Channel1_IRQHandler,
+    DMA1_Channel2_IRQHandler,
+    DMA1_Channel3_IRQHandler,
+    DMA1_Channel4_IRQHandler,
+    DMA1_Channel5_IRQHandler,
+    DMA1_Channel6_IRQHandler,
+    DMA1_Channel7_IRQHandler,
+    ADC1_2_IRQHandler,
+    CAN1_TX_IRQHandler,
+    CAN1_RX0_IRQHandler,            // 20
+    CAN1_RX1_IRQHandler,
+    CAN1_SCE_IRQHandler,
+    EXTI9_5_IRQHandler,
+    TIM1_BRK_TIM15_IRQHandler,
+    TIM1_UP_TIM16_IRQHandler,
+    TIM1_TRG_COM_TIM17_IRQHandler,
+    TIM1_CC_IRQHandler,
+    TIM2_IRQHandler,                // 28: button debounce
+    TIM3_IRQHandler,
+    TIM4_IRQHandler,                // 30
+    I2C1_EV_IRQHandler,
+    I2C1_ER_IRQHandler,
+    I2C2_EV_IRQHandler,
+    I2C2_ER_IRQHandler,
+    SPI1_IRQHandler,
+    SPI2_IRQHandler,
+    USART1_IRQHandler,
+    USART2_IRQHandler,
+    USART3_IRQHandler,
+    EXTI15_10_IRQHandler,           // 40: user button (PC13)
+    RTC_Alarm_IRQHandler,
+    DFSDM1_FLT3_IRQHandler,
+    TIM8_BRK_IRQHandler,
+    TIM8_UP_IRQHandler,
+    TIM8_TRG_COM_IRQHandler,
+    TIM8_CC_IRQHandler,
+    ADC3_IRQHandler,
+    FMC_IRQHandler,
+    SDMMC1_IRQHandler,
+    TIM5_IRQHandler,                // 50
+    SPI3_IRQHandler,
+    UART4_IRQHandler,
+    UART5_IRQHandler,
+    TIM6_DAC_IRQHandler,
+    TIM7_IRQHandler,
+    DMA2_Channel1_IRQHandler,
+    DMA2_Channel2_IRQHandler,
+    DMA2_Channel3_IRQHandler,
+    DMA2_Channel4_IRQHandler,
+    DMA2_Channel5_IRQHandler,       // 60
+    DFSDM1_FLT0_IRQHandler,
+    DFSDM1_FLT1_IRQHandler,
+    DFSDM1_FLT2_IRQHandler,
+    COMP_IRQHandler,
+    LPTIM1_IRQHandler,
+    LPTIM2_IRQHandler,
+    OTG_FS_IRQHandler,
+    DMA2_Channel6_IRQHandler,
+    DMA2_Channel7_IRQHandler,
+    LPUART1_IRQHandler,             // 70
+    QUADSPI_IRQHandler,
+    I2C3_EV_IRQHandler,
+    I2C3_ER_IRQHandler,
+    SAI1_IRQHandler,
+    SAI2_IRQHandler,
+    SWPMI1_IRQHandler,
+    TSC_IRQHandler,
+    LCD_IRQHandler,
+    0,
+    RNG_IRQHandler,                 // 80
+    FPU_IRQHandler
+};
+
+/****************************************************************************
+ * Reset_Handler()
+ * @parameter: None
+ * @return: None
+ * Copies .data (including RAMFUNC code) and .sram2 from flash, zeroes
+ * .bss, sets up the flash accelerator and FPU, and
+ * calls main() on the process stack. The boot timeline starts here;
+ * see boottime.c.
+ ****************************************************************************/
+void Reset_Handler(void)
+{
+    uint32_t *src = &_sidata;
+    uint32_t *dst = &_sdata;
+
+    bootTimerStart();
+    configureFlashAccelerator(RESET_HCLK);
+
+    while (dst < &_edata)
+        *dst++ = *src++;
+
+    src = &_sisram2;
+    for (dst = &_ssram2; dst < &_esram2; dst++)
+        *dst = *src++;
+    bootMark(BOOT_COPY);
+
+    for (dst = &_sbss; dst < &_ebss; dst++)
+        *dst = 0;
+    bootMark(BOOT_ZERO);
+
+#if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
+    SCB->CPACR |= (3UL << 20) | (3UL << 22);  // full access to CP10/CP11
+#endif
+
+    // Thread mode onto the PSP. Nothing of this frame is used after
+    // the switch, so it is safe without returning first.
+    __set_PSP((uint32_t)&_estack_thread);
+    __set_CONTROL(__get_CONTROL() | CONTROL_SPSEL_Msk);
+    __ISB();
+
+    main();
+
+    while (1);
+}
+
+/****************************************************************************
+ * configureFlashAccelerator()
+ * @parameter: hclk - core clock in Hz
+ * @return: None
+ * Range 1 needs one wait state per 16 MHz (0 WS up to 16 MHz, 4 WS at
+ * 80 MHz). Prefetch and the caches hide most of those wait states for
+ * code still running from flash. Call again before raising the clock.
+ ****************************************************************************/
+void configureFlashAccelerator(uint32_t hclk)
+{
+    uint32_t waitStates = (hclk - 1) / 16000000;
+    if (waitStates > 4) waitStates = 4;
+
+    FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | waitStates |
+                 FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+
+    while ((FLASH->ACR & FLASH_ACR_LATENCY) != waitStates);
+}
+
+/****************************************************************************
+ * Default_Handler()
+ * Any interrupt without its own handler ends up here.
+ ****************************************************************************/
+void Default_Handler(void)
+{
+    while (1);
+}
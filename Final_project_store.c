@@ -0,0 +1,314 @@
+#include "store.h"
+#include "flash_port.h"
+
+/*=================================================================
+ * @file: store.c
+ * @brief: Log-structured key/value store in internal flash
+ *
+ * Every entry is one 64-bit double-word, the flash programming unit:
+ *   header (slot 0 of a page): lo = STORE_MAGIC, hi = sequence
+ *   record (slots 1..):       lo = key | ~key << 8 | check << 16,
+ *                             hi = value
+ * A changed value is appended to the active page. The newest record
+ * of a key wins. Flash is never rewritten in place.
+ *
+ * When the active page is full, the next page (round robin, so every
+ * page is erased equally often) is erased and the live values are
+ * copied into it. Its header is programmed last, which commits it.
+ * A power cut at any point leaves either the old page or the new one
+ * as the newest page with a valid header. The old page is not erased
+ * until it comes round again.
+ *
+ * Boot recovery reads one header per page to find the newest, then
+ * replays that page only (O(pages) + one page). Records with a bad
+ * check (a program cut short) are skipped. A cut can leave the low
+ * word programmed and the high word erased, so the check of an
+ * erased high word is one no other value has: such a record only
+ * passes if the value really was 0xFFFFFFFF. On the L4 a read of a
+ * half-programmed double-word is an ECC double error instead;
+ * flash_port.c turns it into an unreadable slot, which is skipped.
+ *
+ * storeService() is a state machine that starts at most one erase
+ * or program per call and returns. It never waits for the flash, so
+ * it can run from the main loop while the game runs in interrupts.
+ * Build with STORE_HOST for the host port (tools/flash_port_file.c).
+ *===============================================================*/
+
+#ifdef STORE_HOST
+#define STORE_LOCK()        0U
+#define STORE_UNLOCK(m)     ((void)(m))
+#else
+#include "stm32l476xx.h"
+#define STORE_LOCK()        storeLock()
+#define STORE_UNLOCK(m)     __set_PRIMASK(m)
+
+static inline uint32_t storeLock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+#endif
+
+#define STORE_MAGIC      0x32474F4CUL   // "LOG2"
+#define STORE_SLOTS      (STORE_PAGE_SIZE / 8)
+#define STORE_NO_PAGE    0xFF
+#define STORE_ERASED     0xFFFFFFFFUL
+#define CHECK_ERASED     0xC35AUL       // recordCheck(STORE_ERASED)
+
+#define STORE_IDLE       0
+#define STORE_ERASING    1
+#define STORE_COPYING    2
+#define STORE_COMMITTING 3
+
+StoreStats storeStats;
+
+static volatile uint32_t values[STORE_MAX_KEYS];
+static volatile uint32_t present;     // keys that have a value
+static volatile uint32_t dirty;       // keys not yet in flash
+
+static uint8_t state = STORE_IDLE;
+static uint8_t target;                // page being filled by a compaction
+static uint16_t copySlot;
+static uint8_t copyKey;
+static int16_t pendingKey = -1;       // key of the record being programmed
+
+/****************************************************************************
+ * recordCheck()
+ * @parameter: value - record value
+ * @return: 16-bit check stored with the record
+ * CHECK_ERASED is kept for an erased high word alone, so a record cut
+ * after its low word never reads back as a good 0xFFFFFFFF.
+ ****************************************************************************/
+static uint32_t recordCheck(uint32_t value)
+{
+    uint32_t check = (value ^ (value >> 16) ^ CHECK_ERASED) & 0xFFFFUL;
+
+    if (check == CHECK_ERASED && value != STORE_ERASED)
+        check ^= 1;                   // 0, 0x00010001, ... would collide
+    return check;
+}
+
+static uint32_t recordLo(uint8_t key, uint32_t value)
+{
+    return key | ((~key & 0xFFUL) << 8) | (recordCheck(value) << 16);
+}
+
+/****************************************************************************
+ * slotOffset()
+ * @parameter: page, slot - double-word index in the page
+ * @return: byte offset in the store region
+ ****************************************************************************/
+static uint32_t slotOffset(uint8_t page, uint16_t slot)
+{
+    return (uint32_t)page * STORE_PAGE_SIZE + (uint32_t)slot * 8;
+}
+
+/****************************************************************************
+ * storeInit()
+ * @parameter: None
+ * @return: None
+ * Picks the page with the highest sequence and replays its records.
+ * With no valid page, the first storeService() call formats page 0.
+ ****************************************************************************/
+void storeInit(void)
+{
+    uint8_t page;
+
+    storeStats.activePage = STORE_NO_PAGE;
+    storeStats.sequence = 0;
+    present = 0;
+    dirty = 0;
+
+    for (page = 0; page < STORE_NUM_PAGES; page++) {
+        uint32_t lo = flashPortRead(slotOffset(page, 0));
+        uint32_t hi = flashPortRead(slotOffset(page, 0) + 4);
+
+        if (lo == STORE_MAGIC && hi != STORE_ERASED && hi >= storeStats.sequence) {
+            storeStats.activePage = page;
+            storeStats.sequence = hi;
+        }
+    }
+
+    if (storeStats.activePage == STORE_NO_PAGE)
+        return;
+
+    page = storeStats.activePage;
+    storeStats.writeSlot = STORE_SLOTS;
+    for (uint16_t slot = 1; slot < STORE_SLOTS; slot++) {
+        uint32_t lo = flashPortRead(slotOffset(page, slot));
+        uint32_t hi = flashPortRead(slotOffset(page, slot) + 4);
+        uint8_t key = lo & 0xFF;
+
+        if (lo == STORE_ERASED && hi == STORE_ERASED) {
+            storeStats.writeSlot = slot;      // end of the log
+            break;
+        }
+        if (key < STORE_MAX_KEYS && lo == recordLo(key, hi)) {
+            values[key] = hi;
+            present |= (1UL << key);
+        }
+        else {
+            storeStats.torn++;
+        }
+    }
+}
+
+/****************************************************************************
+ * storeGet()
+ * @parameter: key - STORE_KEY_*, value - filled on success
+ * @return: 1 if the key has a value, 0 otherwise
+ ****************************************************************************/
+int storeGet(uint8_t key, uint32_t *value)
+{
+    if (key >= STORE_MAX_KEYS || !(present & (1UL << key)))
+        return 0;
+
+    *value = values[key];
+    return 1;
+}
+
+/****************************************************************************
+ * storeSet()
+ * @parameter: key - STORE_KEY_*, value - new value
+ * @return: None
+ * RAM only; an unchanged value is not written again.
+ ****************************************************************************/
+void storeSet(uint8_t key, uint32_t value)
+{
+    uint32_t bit = 1UL << key;
+    uint32_t primask;
+
+    if (key >= STORE_MAX_KEYS)
+        return;
+
+    primask = STORE_LOCK();
+    if (!(present & bit) || values[key] != value) {
+        values[key] = value;
+        present |= bit;
+        dirty |= bit;
+    }
+    STORE_UNLOCK(primask);
+}
+
+/****************************************************************************
+ * markDirty()
+ * @parameter: mask - keys to write again
+ * @return: None
+ ****************************************************************************/
+static void markDirty(uint32_t mask)
+{
+    uint32_t primask = STORE_LOCK();
+    dirty |= mask;
+    STORE_UNLOCK(primask);
+}
+
+/****************************************************************************
+ * takeValue()
+ * @parameter: key - key about to be programmed
+ * @return: its current value
+ * Clears the dirty bit together with the read, so a storeSet() that
+ * comes after this is written again.
+ ****************************************************************************/
+static uint32_t takeValue(uint8_t key)
+{
+    uint32_t primask = STORE_LOCK();
+    uint32_t value = values[key];
+    dirty &= ~(1UL << key);
+    STORE_UNLOCK(primask);
+
+    pendingKey = key;
+    return value;
+}
+
+/****************************************************************************
+ * storeService()
+ * @parameter: None
+ * @return: None
+ ****************************************************************************/
+void storeService(void)
+{
+    int error;
+
+    if (flashPortBusy())
+        return;
+
+    error = flashPortError();
+    if (error) {
+        storeStats.errors++;
+        if (pendingKey >= 0)
+            markDirty(1UL << pendingKey);     // write it again later
+    }
+    pendingKey = -1;
+
+    switch (state) {
+    case STORE_IDLE:
+        if (storeStats.activePage == STORE_NO_PAGE ||
+            (dirty && storeStats.writeSlot >= STORE_SLOTS)) {
+            // Compact into the next page
+            target = (storeStats.activePage == STORE_NO_PAGE)
+                         ? 0 : (storeStats.activePage + 1) % STORE_NUM_PAGES;
+            copySlot = 1;
+            copyKey = 0;
+            flashPortStartErase(target);
+            state = STORE_ERASING;
+        }
+        else if (dirty) {
+            uint8_t key = 0;
+            while (!(dirty & (1UL << key)))
+                key++;
+
+            uint32_t value = takeValue(key);
+            flashPortStartProgram(slotOffset(storeStats.activePage, storeStats.writeSlot),
+                                  recordLo(key, value), value);
+            storeStats.writeSlot++;
+            storeStats.records++;
+        }
+        break;
+
+    case STORE_ERASING:
+        state = error ? STORE_IDLE : STORE_COPYING;   // retry from scratch on error
+        break;
+
+    case STORE_COPYING:
+        while (copyKey < STORE_MAX_KEYS && !(present & (1UL << copyKey)))
+            copyKey++;
+
+        if (copyKey < STORE_MAX_KEYS) {
+            uint32_t value = takeValue(copyKey);
+            flashPortStartProgram(slotOffset(target, copySlot), recordLo(copyKey, value), value);
+            copySlot++;
+            copyKey++;
+        }
+        else {
+            // Everything copied: the header commits the page
+            flashPortStartProgram(slotOffset(target, 0), STORE_MAGIC, storeStats.sequence + 1);
+            state = STORE_COMMITTING;
+        }
+        break;
+
+    case STORE_COMMITTING:
+        if (!error) {
+            storeStats.activePage = target;
+            storeStats.sequence++;
+            storeStats.writeSlot = copySlot;
+            storeStats.compactions++;
+        }
+        else {
+            markDirty(present);               // copies were not committed
+        }
+        state = STORE_IDLE;
+        break;
+    }
+}
+
+/****************************************************************************
+ * storeIdle()
+ * @parameter: None
+ * @return: 1 if nothing is waiting to be written
+ ****************************************************************************/
+int storeIdle(void)
+{
+    return state == STORE_IDLE && !dirty && !flashPortBusy() &&
+           storeStats.activePage != STORE_NO_PAGE;
+}
@@ -0,0 +1,51 @@
+#ifndef STORE_H
+#define STORE_H
+
+/*************************************************
+ * @file: store.h
+ *
+ * Header file for store.c
+ * Small persistent key/value store (32-bit values) kept as an
+ * append-only log in internal flash. Values live in RAM; flash is
+ * written in the background by storeService().
+ *************************************************/
+
+#include <stdint.h>
+
+// Keys
+#define STORE_KEY_P1_SCORE 0
+#define STORE_KEY_P2_SCORE 1
+#define STORE_KEY_SERVER   2
+#define STORE_KEY_SPEED    3
+#define STORE_KEY_MODE     4
+#define STORE_MAX_KEYS     16
+
+typedef struct {
+    uint32_t sequence;     // generation of the active page
+    uint8_t  activePage;
+    uint16_t writeSlot;    // next free double-word in the active page
+    uint32_t records;      // records written
+    uint32_t compactions;
+    uint32_t torn;         // unreadable records skipped at boot
+    uint32_t errors;       // flash operations that reported an error
+} StoreStats;
+
+extern StoreStats storeStats;
+
+// Boot recovery: finds the newest page and replays it. Call once.
+void storeInit(void);
+
+// Returns 1 and fills value if the key has one
+int storeGet(uint8_t key, uint32_t *value);
+
+// Updates RAM and marks the key for writing. Safe from interrupts.
+void storeSet(uint8_t key, uint32_t value);
+
+// Runs at most one flash step and never waits for the flash.
+// Call from the main loop.
+void storeService(void);
+
+// 1 when every value is in flash
+int storeIdle(void);
+
+#endif
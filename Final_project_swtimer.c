@@ -0,0 +1,141 @@
+#include "swtimer.h"
+#include "pool.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: swtimer.c
+ * @brief: Pooled one-shot and periodic software timers
+ *
+ * Running timers are kept on one unsorted list; with TIMER_MAX
+ * entries a scan is cheaper than keeping it ordered. After every
+ * service the earliest due time goes to timerWake(), so nothing
+ * polls the list while no timer is close to firing.
+ *
+ * The list is shared with whatever starts or stops timers (the game
+ * step in PendSV does), so it is only touched with PRIMASK set. The
+ * callback itself runs with interrupts enabled.
+ *===============================================================*/
+
+// Signed distance a - b for the wrapping 32-bit TIM5 count
+#define TIME_DIFF(a, b) ((int32_t)((a) - (b)))
+
+POOL_DEFINE(timerPool, SoftTimer, TIMER_MAX);
+
+static SoftTimer *running;
+
+/****************************************************************************
+ * timerStart()
+ * @parameter: ms - delay (and period) in milliseconds, fn/arg - callback,
+ *             periodic - TIMER_ONESHOT or TIMER_PERIODIC
+ * @return: the timer, or NULL if the pool is empty
+ ****************************************************************************/
+SoftTimer *timerStart(uint32_t ms, TimerFn fn, void *arg, uint8_t periodic)
+{
+    SoftTimer *t = poolAlloc(&timerPool);
+    uint32_t primask;
+
+    if (!t)
+        return 0;
+
+    t->period = periodic ? ms * TIMER_COUNTS_PER_MS : 0;
+    t->fn = fn;
+    t->arg = arg;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    t->due = TIM5->CNT + ms * TIMER_COUNTS_PER_MS;
+    t->next = running;
+    running = t;
+    __set_PRIMASK(primask);
+
+    timerWake(t->due);
+    return t;
+}
+
+/****************************************************************************
+ * timerStop()
+ * @parameter: t - timer from timerStart(), NULL is ignored
+ * @return: None
+ ****************************************************************************/
+void timerStop(SoftTimer *t)
+{
+    uint32_t primask = __get_PRIMASK();
+    SoftTimer **link;
+    uint8_t found = 0;
+
+    __disable_irq();
+    for (link = &running; *link; link = &(*link)->next) {
+        if (*link == t) {
+            *link = t->next;
+            found = 1;
+            break;
+        }
+    }
+    __set_PRIMASK(primask);
+
+    if (found)
+        poolFree(&timerPool, t);
+}
+
+/****************************************************************************
+ * timerService()
+ * @parameter: None
+ * @return: None
+ * One due timer per pass, so a callback may start or stop timers
+ * (itself included) without upsetting the scan.
+ ****************************************************************************/
+void timerService(void)
+{
+    SoftTimer **link;
+    SoftTimer *t;
+    TimerFn fn;
+    void *arg;
+    uint32_t now, earliest;
+    uint8_t any;
+
+    while (1)
+    {
+        fn = 0;
+        arg = 0;
+        now = TIM5->CNT;
+
+        __disable_irq();
+        for (link = &running; *link; link = &(*link)->next) {
+            t = *link;
+            if (TIME_DIFF(now, t->due) < 0)
+                continue;
+
+            fn = t->fn;
+            arg = t->arg;
+            if (t->period) {
+                t->due += t->period;
+                if (TIME_DIFF(now, t->due) >= 0)
+                    t->due = now + t->period;      // far behind: realign
+            }
+            else {
+                *link = t->next;
+                poolFree(&timerPool, t);
+            }
+            break;
+        }
+        __enable_irq();
+
+        if (!fn)
+            break;
+        fn(arg);
+    }
+
+    any = 0;
+    earliest = 0;
+    __disable_irq();
+    for (t = running; t; t = t->next) {
+        if (!any || TIME_DIFF(t->due, earliest) < 0)
+            earliest = t->due;
+        any = 1;
+    }
+    __enable_irq();
+
+    if (any)
+        timerWake(earliest);
+}
@@ -0,0 +1,51 @@
+#ifndef SWTIMER_H
+#define SWTIMER_H
+
+/*************************************************
+ * @file: swtimer.h
+ *
+ * Header file for swtimer.c
+ * Software timers on the TIM5 time base, taken from a fixed pool
+ * (pool.h) of TIMER_MAX. Callbacks run in timerService(), i.e. in
+ * thread mode from a scheduler task, never in an interrupt.
+ *
+ * A one-shot timer goes back to the pool when it fires, so its
+ * handle must not be stopped afterwards. A periodic timer runs
+ * until timerStop(), which is also allowed from its own callback.
+ * timerService() takes the callback under PRIMASK but calls it with
+ * interrupts enabled, so a timerStop() from an interrupt in that gap
+ * does not stop the call already taken. A callback sharing state
+ * with an interrupt has to check for that (leds.c passes a
+ * generation in arg).
+ *************************************************/
+
+#include <stdint.h>
+
+#define TIMER_MAX           8
+#define TIMER_COUNTS_PER_MS 4000   // TIM5 at 4 MHz
+
+#define TIMER_ONESHOT  0
+#define TIMER_PERIODIC 1
+
+typedef void (*TimerFn)(void *arg);
+
+typedef struct SoftTimer {
+    struct SoftTimer *next;
+    uint32_t due;        // TIM5 count
+    uint32_t period;     // counts, 0 = one-shot
+    TimerFn fn;
+    void *arg;
+} SoftTimer;
+
+// Returns NULL when all TIMER_MAX timers are in use (timerPool.exhausted)
+SoftTimer *timerStart(uint32_t ms, TimerFn fn, void *arg, uint8_t periodic);
+void timerStop(SoftTimer *t);
+
+// Runs the callbacks of every timer that is due
+void timerService(void);
+
+// Supplied by the application: have timerService() run at TIM5
+// count `due` (or earlier). Called from any context.
+void timerWake(uint32_t due);
+
+#endif
@@ -0,0 +1,99 @@
+#include "tickless.h"
+#include "irq.h"
+#include "stm32l476xx.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: tickless.c
+ * @brief: One-shot compare events for tickless game modes
+ *
+ * TIM5 is the free-running capture time base (capture.c) and its
+ * compare channel 2 already wakes the scheduler (sched.c); channel 1
+ * is used here. Arming writes CCR1 and enables the CC1 interrupt;
+ * the interrupt disables itself again, so each arm is one event.
+ *
+ * A time that has already passed when it is armed would only match
+ * after the counter wraps (18 minutes), so that case pends the tick
+ * straight away. A spare PendSV is harmless: the tick hook only acts
+ * on what is due.
+ *===============================================================*/
+
+// Signed distance a - b for the wrapping 32-bit TIM5 count
+#define TIME_DIFF(a, b) ((int32_t)((a) - (b)))
+
+volatile TicklessStats ticklessStats;
+
+/****************************************************************************
+ * init_Tickless()
+ * @parameter: None
+ * @return: None
+ * Channel 1 as a plain compare (frozen output), interrupt off until
+ * the first ticklessArm().
+ ****************************************************************************/
+void init_Tickless(void)
+{
+    TIM5->DIER &= ~TIM_DIER_CC1IE;
+    TIM5->CCMR1 &= ~(TIM_CCMR1_CC1S | TIM_CCMR1_OC1M);
+    TIM5->SR = ~TIM_SR_CC1IF;
+    NVIC_EnableIRQ(TIM5_IRQn);
+}
+
+/****************************************************************************
+ * ticklessArm()
+ * @parameter: when - TIM5 count of the event
+ * @return: None
+ * Called from the tick hook (PendSV) or the mode switch.
+ ****************************************************************************/
+RAMFUNC void ticklessArm(uint32_t when)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    TIM5->CCR1 = when;
+    TIM5->SR = ~TIM_SR_CC1IF;     // rc_w0: a plain write leaves CC2IF alone
+    TIM5->DIER |= TIM_DIER_CC1IE;
+    ticklessStats.armed++;
+
+    if (TIME_DIFF(TIM5->CNT, when) >= 0) {
+        TIM5->DIER &= ~TIM_DIER_CC1IE;
+        ticklessStats.immediate++;
+        deferToPendSV();
+    }
+    __set_PRIMASK(primask);
+}
+
+/****************************************************************************
+ * ticklessDisarm()
+ * @parameter: None
+ * @return: None
+ ****************************************************************************/
+RAMFUNC void ticklessDisarm(void)
+{
+    TIM5->DIER &= ~TIM_DIER_CC1IE;
+    TIM5->SR = ~TIM_SR_CC1IF;
+}
+
+/****************************************************************************
+ * ticklessIrq()
+ * @parameter: None
+ * @return: None
+ * Only acts on an armed compare: channel 1 matches every time the
+ * counter passes CCR1, armed or not.
+ ****************************************************************************/
+RAMFUNC void ticklessIrq(void)
+{
+    uint32_t late;
+
+    if (!(TIM5->DIER & TIM_DIER_CC1IE) || !(TIM5->SR & TIM_SR_CC1IF))
+        return;
+
+    TIM5->SR = ~TIM_SR_CC1IF;
+    TIM5->DIER &= ~TIM_DIER_CC1IE;
+
+    late = TIM5->CNT - TIM5->CCR1;
+    ticklessStats.fired++;
+    if (late > ticklessStats.worstLate)
+        ticklessStats.worstLate = late;
+
+    deferToPendSV();
+}
@@ -0,0 +1,38 @@
+#ifndef TICKLESS_H
+#define TICKLESS_H
+
+/*************************************************
+ * @file: tickless.h
+ *
+ * Header file for tickless.c
+ * One-shot game events on TIM5 compare channel 1. A tickless mode
+ * (no tickPeriod in gameModes[]) arms the absolute TIM5 time of its
+ * next event; at that time its tick hook runs in PendSV, once, and
+ * arms the one after. Nothing fires in between. TIM5 counts 4 per
+ * microsecond, so events land to 250 ns.
+ *************************************************/
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t armed;       // events scheduled
+    uint32_t fired;       // compare interrupts taken
+    uint32_t immediate;   // armed for a time already past
+    uint32_t worstLate;   // compare match -> handler, TIM5 counts
+} TicklessStats;
+
+extern volatile TicklessStats ticklessStats;
+
+// TIM5 must be running (init_Capture())
+void init_Tickless(void);
+
+// Run the game tick once at TIM5 count `when` (replaces any armed time)
+void ticklessArm(uint32_t when);
+
+// No event armed
+void ticklessDisarm(void);
+
+// Compare 1 part of TIM5_IRQHandler (sched.c)
+void ticklessIrq(void);
+
+#endif
@@ -0,0 +1,88 @@
+#include "wcet.h"
+#include "memmap.h"
+
+/*=================================================================
+ * @file: wcet.c
+ * @brief: Interrupt handler execution time tracking
+ *
+ * Handlers read WCET_START() on entry and call wcetStop() on exit.
+ * Each call updates the last/worst cycle counts, and any call over
+ * budget is counted, so blocking code added to a handler shows up
+ * even outside the bench.
+ *===============================================================*/
+
+volatile WcetRecord wcet[NUM_WCET_HANDLERS];
+
+static const uint32_t budgets[NUM_WCET_HANDLERS] = {
+    [WCET_SYSTICK] = WCET_BUDGET_SYSTICK,
+    [WCET_INPUT]   = WCET_BUDGET_INPUT,
+    [WCET_EXTI0]   = WCET_BUDGET_EXTI,
+    [WCET_EXTI1]   = WCET_BUDGET_EXTI,
+    [WCET_PENDSV]  = WCET_BUDGET_PENDSV,
+    [WCET_EXTI15_10] = WCET_BUDGET_EXTI
+};
+
+/****************************************************************************
+ * wcetInit()
+ * @parameter: None
+ * @return: None
+ * Starts the DWT cycle counter and loads the budgets.
+ ****************************************************************************/
+void wcetInit(void)
+{
+    // CYCCNT keeps running from reset (boot timeline); only deltas are used
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    wcetReset();
+}
+
+/****************************************************************************
+ * wcetReset()
+ * @parameter: None
+ * @return: None
+ * Clears all records, keeping the budgets.
+ ****************************************************************************/
+void wcetReset(void)
+{
+    for (int i = 0; i < NUM_WCET_HANDLERS; i++) {
+        wcet[i].last = 0;
+        wcet[i].worst = 0;
+        wcet[i].budget = budgets[i];
+        wcet[i].calls = 0;
+        wcet[i].overruns = 0;
+    }
+}
+
+/****************************************************************************
+ * wcetStop()
+ * @parameter: handler - WCET_* slot, start - WCET_START() value from entry
+ * @return: None
+ * Runs from SRAM, since every instrumented handler calls it.
+ ****************************************************************************/
+RAMFUNC void wcetStop(uint8_t handler, uint32_t start)
+{
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    wcet[handler].last = cycles;
+    wcet[handler].calls++;
+    if (cycles > wcet[handler].worst)
+        wcet[handler].worst = cycles;
+    if (cycles > wcet[handler].budget)
+        wcet[handler].overruns++;
+}
+
+/****************************************************************************
+ * wcetCheckBudgets()
+ * @parameter: None
+ * @return: bit n set if handler n's worst case is over its budget
+ ****************************************************************************/
+uint32_t wcetCheckBudgets(void)
+{
+    uint32_t failed = 0;
+
+    for (int i = 0; i < NUM_WCET_HANDLERS; i++)
+        if (wcet[i].worst > wcet[i].budget)
+            failed |= (1UL << i);
+
+    return failed;
+}
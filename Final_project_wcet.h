@@ -0,0 +1,49 @@
+#ifndef WCET_H
+#define WCET_H
+
+/*************************************************
+ * @file: wcet.h
+ *
+ * Header file for wcet.c
+ * Worst-case execution time tracking for the interrupt handlers,
+ * measured in core cycles with the DWT cycle counter.
+ *************************************************/
+
+#include "stm32l476xx.h"
+
+// Handler slots
+#define WCET_SYSTICK 0
+#define WCET_INPUT   1   // button sampling (sampler.c, or TIM2)
+#define WCET_EXTI0   2
+#define WCET_EXTI1   3
+#define WCET_PENDSV  4
+#define WCET_EXTI15_10 5
+#define NUM_WCET_HANDLERS 6
+
+// Cycle budgets per handler (4 MHz core: 4 cycles = 1 us)
+#define WCET_BUDGET_SYSTICK 300
+#define WCET_BUDGET_PENDSV  2000
+#define WCET_BUDGET_INPUT   1200  // a 32-sample batch with every lane settling
+#define WCET_BUDGET_EXTI    400
+
+typedef struct {
+    uint32_t last;      // cycles of the most recent call
+    uint32_t worst;     // highest cycles seen
+    uint32_t budget;    // allowed cycles
+    uint32_t calls;
+    uint32_t overruns;  // calls that went over budget
+} WcetRecord;
+
+extern volatile WcetRecord wcet[NUM_WCET_HANDLERS];
+
+// Read at handler entry, pass the value to wcetStop() at exit
+#define WCET_START() (DWT->CYCCNT)
+
+void wcetInit(void);
+void wcetStop(uint8_t handler, uint32_t start);
+void wcetReset(void);
+
+// Returns a bit mask of handlers whose worst case exceeded their budget
+uint32_t wcetCheckBudgets(void);
+
+#endif
@@ -1,6 +1,8 @@
 
 #include "stm32l476xx.h"
 #include "led_setup.h"
+#include "wcet.h"
+#include "coro.h"
 
 /**
  ******************************************
@@ -15,6 +17,8 @@
  *  A integer called pattern is used to determine what leds are lit depeding on the mode.
  *  Systick, defined speeds, and an array are used to determine the speed of frequency of events.
  * A form of debouncing is used to resolve noise between button presses.
+ * Pressing both buttons together (a chord) toggles the mode. The chord
+ * check is a coroutine stepped by SysTick, so nothing spins waiting.
  */
 
 #define SYS_CLK_FREQ 4000000 // determines the frequency of Systick
@@ -26,6 +30,12 @@
 #define MEDIUM ((SYS_CLK_FREQ / 10) - 1)
 #define FAST   ((SYS_CLK_FREQ / 15) - 1)
 
+// Chord check: the second button may follow the first by CHORD_TICKS ticks
+#define CHORD_TICKS 2
+#define CHORD_EDGE  0x01                    // event: a button edge (EXTI)
+#define RIGHT_DOWN() ((GPIOC->IDR & (1UL << 0)) == 0)
+#define LEFT_DOWN()  ((GPIOC->IDR & (1UL << 1)) == 0)
+
 // Create an array of speeds
 static const uint32_t speeds[] = {SLOW, MEDIUM, FAST};
 static volatile int speedIndex = 0; // variable used for determined the speed
@@ -39,6 +49,7 @@ static volatile uint8_t ledPattern = 0x01; // start PC8 lit
 static volatile uint8_t led_mode = SINGLE_LED_MODE;
 static volatile uint8_t direction  = 1;
 static volatile uint8_t blinkstate;
+static Coro chordCo;
 
 extern volatile uint8_t led_mode;
 extern volatile uint8_t ledPattern; // allows access to this integer to led_setup
@@ -48,7 +59,10 @@ void configureSysTick(void);
 void SysTick_Handler(void);
 void EXTI0_IRQHandler(void);
 void EXTI1_IRQHandler(void);
-void handleDualButtonPress(void);
+static uint8_t chordFlow(Coro *co);
+#ifdef WCET_BENCH
+static void runWcetBench(void);
+#endif
 
 //--------------------------------------------------------------------------------
 // main()
@@ -59,6 +73,11 @@ int main(void)
     init_Buttons();          // from led_setup
     init_LEDs_PC6to13();     // from led_setup
 
+    wcetInit(); // track handler execution times
+#ifdef WCET_BENCH
+    runWcetBench();
+#endif
+
     configureSysTick(); // function in main.c
         // 4) Start SysTick
     START_SYSTICK();
@@ -66,20 +85,8 @@ int main(void)
     while (1)
       {
           // Continuously write the current pattern to the pins
+          // (mode changes come from chordFlow() in SysTick)
           update_LEDs_PC6to13(ledPattern, led_mode);
-          // Poll buttons with a delay for debounce.
-              if (((GPIOC->IDR & (1UL << 0)) == 0) && ((GPIOC->IDR & (1UL << 1)) == 0))
-              {
-                  // Both buttons pressed: toggle mode.
-                  if (led_mode == SINGLE_LED_MODE)
-                      led_mode = FLASH_LED_MODE;
-                  else
-                      led_mode = SINGLE_LED_MODE;
-                      ledPattern = 0x01;
-                  // Wait a little to avoid repeated toggling.
-                  for (volatile int i = 0; i < 500000; i++);
-              }
-
       }
   }
 
@@ -117,6 +124,11 @@ void configureSysTick(void)
  */
 void SysTick_Handler(void)
 {
+    uint32_t start = WCET_START();
+
+    // Both buttons down together toggles the mode
+    chordFlow(&chordCo);
+
     // Only update the pattern if we are in SINGLE_LED_MODE.
     if (led_mode == SINGLE_LED_MODE) {
         // Check the right button (PC0) for right-to-left shift.
@@ -176,7 +188,48 @@ void SysTick_Handler(void)
                 SysTick->LOAD = speeds[speedIndex];
             }
         }
+
+    wcetStop(WCET_SYSTICK, start);
+}
+/*==================================================================
+ * chordFlow()
+ *
+ * @param: co - coroutine state (chordCo)
+ * @return: CORO_RUNNING / CORO_DONE
+ *
+ * One step per SysTick. Waits for a first button, gives the second
+ * one CHORD_TICKS ticks to join, toggles the mode if both are down,
+ * then waits for both to be released so one chord toggles once.
+ * This replaces the polling delay loops in main() and the EXTI
+ * handlers.
+ *==================================================================*/
+static uint8_t chordFlow(Coro *co)
+{
+    static uint8_t ticksLeft;
+
+    CORO_BEGIN(co);
+
+    // A tap shorter than a tick still counts, via the EXTI edge event
+    CORO_AWAIT_UNTIL(co, coroTake(co, CHORD_EDGE) || RIGHT_DOWN() || LEFT_DOWN());
+
+    for (ticksLeft = CHORD_TICKS; !(RIGHT_DOWN() && LEFT_DOWN()) && ticksLeft; ticksLeft--)
+        CORO_YIELD(co);
+
+    if (RIGHT_DOWN() && LEFT_DOWN()) {
+        if (led_mode == SINGLE_LED_MODE) {
+            led_mode = FLASH_LED_MODE;
+        } else {
+            led_mode = SINGLE_LED_MODE;
+            ledPattern = 0x01;
+        }
+    }
+
+    CORO_AWAIT_UNTIL(co, !RIGHT_DOWN() && !LEFT_DOWN());
+    coroTake(co, CHORD_EDGE);   // bounces while the chord was held
+
+    CORO_END(co);
 }
+
 /*==================================================================
  * EXTI0_IRQHANDLER()
  *
@@ -184,11 +237,13 @@ void SysTick_Handler(void)
  * @return: none
  *
  * Trigger EXTI interrupt for port-C pin 0 (right button)
- * Check if both buttons are being pressed.
+ * Tells the chord check that a button moved.
  *==================================================================*/
 void EXTI0_IRQHandler(void)
 {
-    handleDualButtonPress();
+    uint32_t start = WCET_START();
+    coroPost(&chordCo, CHORD_EDGE);
+    wcetStop(WCET_EXTI0, start);
 }
 /*==================================================================
  * EXTI_IRQHANDLER()
@@ -197,41 +252,53 @@ void EXTI0_IRQHandler(void)
  * @return: none
  *
  * Trigger EXTI interrupt for port-C pin 1(left button)
- * Also checks if both buttons are pressed.
+ * Tells the chord check that a button moved.
  *==================================================================*/
 void EXTI1_IRQHandler(void)
 {
-    handleDualButtonPress();
+    uint32_t start = WCET_START();
+    coroPost(&chordCo, CHORD_EDGE);
+    wcetStop(WCET_EXTI1, start);
 }
 
+#ifdef WCET_BENCH
 /*==================================================================
- * handleDualButtonPress(void)
+ * runWcetBench(void)
  *
  * @param: none
  * @return: none
  *
- * Triggered by the EXTI interrupts, check with in a delay rate.
- * If both buttons are pressed within the delay rate, logic for mode switching is triggered.
+ * Calls every handler once in each mode and at both ends of the LED bar.
+ * Halts if any handler's worst case is over budget (see wcet[]).
  *==================================================================*/
-
-void handleDualButtonPress(void)
+static void runWcetBench(void)
 {
-	for(volatile int i = 0; i < 1000; i++) // recursive delay meant to detect the button presses
-	{
-    // Check PC0 and PC1 have been pressed during the delay rate
-    if (((GPIOC->IDR & (1UL << 0)) == 0) && ((GPIOC->IDR & (1UL << 1)) == 0))
+    static const uint8_t patterns[] = {0x01, 0x0F, 0x80};
+
+    for (int mode = SINGLE_LED_MODE; mode <= FLASH_LED_MODE; mode++)
     {
-        // Both buttons are pressed (active-low), so toggle if statement
-        if (led_mode == SINGLE_LED_MODE)
+        for (int p = 0; p < 3; p++)
         {
-            led_mode = FLASH_LED_MODE; // switch to other mode
+            led_mode = mode;
+            ledPattern = patterns[p];
+            SysTick_Handler();
+
+            led_mode = mode;
+            EXTI0_IRQHandler();
+            EXTI1_IRQHandler();
         }
-        else if (led_mode == FLASH_LED_MODE)
-        {
-            led_mode = SINGLE_LED_MODE; // stay in the same mode
-            ledPattern = 0x01;
+    }
+
+    led_mode = SINGLE_LED_MODE;
+    ledPattern = 0x01;
+    speedIndex = 0;
+
+    if (wcetCheckBudgets() != 0)
+    {
+        __BKPT(0);
+        while (1);
+    }
 
-     }
-   }
- }
+    wcetReset();
 }
+#endif
@@ -0,0 +1,67 @@
+#!/bin/sh
+#
+# build_emu.sh
+#
+# Builds the Pong firmware (Final_main_withtimer2.c and its modules) into
+# emu/build/pong.elf for the Renode machine in emu/pong.resc. The same ELF
+# also runs on the Nucleo-L476RG.
+#
+# Needs arm-none-eabi-gcc and the CMSIS device headers:
+#   CMSIS_DIR=/path/to/STM32CubeL4/Drivers/CMSIS emu/build_emu.sh
+#
+# The sources include their headers by short name (led_setup.h, buttons.h,
+# ...), so the Final_project_*.h headers are linked into build/include
+# under those names first.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT="$ROOT/emu/build"
+CMSIS_DIR=${CMSIS_DIR:?set CMSIS_DIR to the STM32CubeL4 Drivers/CMSIS directory}
+CC=${CC:-arm-none-eabi-gcc}
+
+mkdir -p "$OUT/include"
+for h in "$ROOT"/Final_project_*.h; do
+    name=$(basename "$h")
+    ln -sf "$h" "$OUT/include/${name#Final_project_}"
+done
+ln -sf "$ROOT/Final_project_leds.h" "$OUT/include/led_setup.h"
+
+SOURCES="$ROOT/Final_main_withtimer2.c"
+for c in "$ROOT"/Final_project_*.c; do
+    SOURCES="$SOURCES $c"
+done
+# Final_project_main.c is the earlier SysTick-debounce version of main()
+SOURCES=$(echo "$SOURCES" | tr ' ' '\n' | grep -v 'Final_project_main.c' | tr '\n' ' ')
+
+# The Renode machine has no DMA model, so buttons are debounced by the
+# TIM2 interrupt (INPUT_TIM2) instead of the TIM16 + DMA sampler.
+CFLAGS="-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard \
+    -DSTM32L476xx -DINPUT_TIM2 -O2 -g3 -std=gnu11 -Wall \
+    -ffunction-sections -fdata-sections \
+    -I$OUT/include \
+    -I$CMSIS_DIR/Device/ST/STM32L4xx/Include \
+    -I$CMSIS_DIR/Include $EXTRA_CFLAGS"
+
+# One object per module, so the map (and the RAM report) names them
+mkdir -p "$OUT/obj"
+rm -f "$OUT"/obj/*.o
+OBJECTS=""
+for c in $SOURCES; do
+    o="$OUT/obj/$(basename "${c%.c}").o"
+    $CC $CFLAGS -c "$c" -o "$o"
+    OBJECTS="$OBJECTS $o"
+done
+
+$CC $CFLAGS $OBJECTS \
+    -T"$ROOT/STM32L476RGTX_FLASH.ld" \
+    -nostartfiles --specs=nano.specs -Wl,--gc-sections \
+    -Wl,-Map="$OUT/pong.map" \
+    -o "$OUT/pong.elf"
+
+# Erased store pages (STORE_BASE, STORE_SIZE in flash_port.h) for pong.resc
+head -c 8192 /dev/zero | tr '\000' '\377' > "$OUT/store_erased.bin"
+
+arm-none-eabi-size "$OUT/pong.elf"
+"$ROOT/tools/hot_symbols.sh" "$OUT/pong.elf"
+"$ROOT/tools/ram_report.sh" "$OUT/pong.map"
@@ -0,0 +1,195 @@
+/*=================================================================
+ * @file: debounce_host.c
+ * @brief: Host check and benchmark of the batch debouncer
+ *
+ * Builds a long port-sample stream at SAMPLER_RATE with three
+ * button lanes (PC0, PC1, PC13) pressing and releasing through
+ * random contact bounce, feeds it to debounceBatch() in
+ * SAMPLER_BATCH chunks like sampler.c does, and checks every true
+ * edge is reported once, dated to its first raw edge. The same
+ * stream is also run through one debounceShift() per lane, one
+ * sample at a time, for a speed comparison:
+ *
+ *   gcc -O2 -I<headers> Final_project_debounce.c \
+ *       tools/debounce_host.c -o debounce_host
+ *   ./debounce_host [-n presses] [-b bounce] [-s seed]
+ *
+ * bounce is the longest chatter after an edge, in samples. Exit 0
+ * when no edge is missed, doubled or misdated.
+ *===============================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include "debounce.h"
+
+#define SAMPLER_RATE  2000        // as sampler.h
+#define SAMPLER_BATCH 32
+#define MAX_EDGES     8
+#define LANES         3
+#define REPEAT        50          // timing passes over the stream
+
+static const uint8_t lanePin[LANES] = { 0, 1, 13 };
+
+typedef struct {
+    uint32_t sample;
+    uint8_t lane;
+    uint8_t level;
+    uint8_t seen;
+} TrueEdge;
+
+static uint16_t *stream;
+static uint32_t streamLen;
+static TrueEdge *truth;
+static uint32_t numTruth;
+
+static double seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Press/release each lane in turn: idle, bounce, hold, bounce, idle
+static void buildStream(int presses, int bounce)
+{
+    uint32_t cap = (uint32_t)presses * LANES * 2 * (200 + 2 * (uint32_t)bounce) + 1024;
+    uint16_t level = 0;
+    uint32_t t = 0;
+
+    for (int l = 0; l < LANES; l++)
+        level |= (uint16_t)(1U << lanePin[l]);
+
+    stream = malloc(cap * sizeof(*stream));
+    truth = malloc((size_t)presses * LANES * 2 * sizeof(*truth));
+
+    for (int p = 0; p < presses; p++)
+    for (int l = 0; l < LANES; l++)
+    for (int edge = 0; edge < 2; edge++) {
+        uint16_t bit = (uint16_t)(1U << lanePin[l]);
+        uint32_t hold = 60 + (uint32_t)(rand() % 120);   // 30..90 ms
+        int chatter = bounce ? rand() % (bounce + 1) : 0;
+        uint32_t start = t;
+
+        level ^= bit;
+        for (int i = 0; i < chatter; i++)
+            stream[t++] = (rand() & 1) ? level : (uint16_t)(level ^ bit);
+        for (uint32_t i = 0; i < hold; i++)
+            stream[t++] = level;
+
+        // True edge time: the first sample at the new level
+        while ((stream[start] & bit) != (level & bit))
+            start++;
+        truth[numTruth].sample = start;
+        truth[numTruth].lane = lanePin[l];
+        truth[numTruth].level = (level & bit) != 0;
+        truth[numTruth].seen = 0;
+        numTruth++;
+    }
+    streamLen = t;
+}
+
+static int checkEdges(void)
+{
+    BatchDebouncer d;
+    BatchEdge edges[MAX_EDGES];
+    uint32_t next = 0, bad = 0;
+    uint16_t mask = 0;
+
+    for (int l = 0; l < LANES; l++)
+        mask |= (uint16_t)(1U << lanePin[l]);
+    debounceBatchInit(&d, mask);
+
+    for (uint32_t at = 0; at + SAMPLER_BATCH <= streamLen; at += SAMPLER_BATCH) {
+        uint8_t n = debounceBatch(&d, &stream[at], SAMPLER_BATCH, edges, MAX_EDGES);
+
+        for (uint8_t i = 0; i < n; i++) {
+            // Edges come out in order; match the next unseen one of the lane
+            uint32_t k = next;
+            while (k < numTruth && (truth[k].seen || truth[k].lane != edges[i].lane))
+                k++;
+            if (k == numTruth || truth[k].level != edges[i].level ||
+                truth[k].sample != edges[i].sample) {
+                printf("bad edge: lane %u level %u at %u\n",
+                       edges[i].lane, edges[i].level, edges[i].sample);
+                bad++;
+                continue;
+            }
+            truth[k].seen = 1;
+            while (next < numTruth && truth[next].seen)
+                next++;
+        }
+    }
+
+    // The last edges may still be settling at the end of the stream
+    for (uint32_t k = 0; k + LANES * 2 < numTruth; k++)
+        if (!truth[k].seen) {
+            printf("missed edge: lane %u at %u\n", truth[k].lane, truth[k].sample);
+            bad++;
+        }
+    return bad == 0 && d.lost == 0;
+}
+
+static void timeKernels(void)
+{
+    BatchDebouncer d;
+    BatchEdge edges[MAX_EDGES];
+    ShiftDebouncer shift[LANES];
+    volatile uint32_t sink = 0;
+    double t0, tBatch, tShift;
+    uint32_t samples = (streamLen / SAMPLER_BATCH) * SAMPLER_BATCH;
+
+    t0 = seconds();
+    for (int r = 0; r < REPEAT; r++) {
+        debounceBatchInit(&d, 0x2003);
+        for (uint32_t at = 0; at < samples; at += SAMPLER_BATCH)
+            sink += debounceBatch(&d, &stream[at], SAMPLER_BATCH, edges, MAX_EDGES);
+    }
+    tBatch = seconds() - t0;
+
+    t0 = seconds();
+    for (int r = 0; r < REPEAT; r++) {
+        for (int l = 0; l < LANES; l++)
+            debounceShiftInit(&shift[l]);
+        for (uint32_t at = 0; at < samples; at++)
+            for (int l = 0; l < LANES; l++)
+                sink += debounceShift(&shift[l], (stream[at] >> lanePin[l]) & 1U);
+    }
+    tShift = seconds() - t0;
+
+    printf("%u samples x %d: batch %.2f ns/sample, per-sample shift %.2f ns/sample\n",
+           samples, REPEAT, tBatch * 1e9 / ((double)samples * REPEAT),
+           tShift * 1e9 / ((double)samples * REPEAT));
+    (void)sink;
+}
+
+int main(int argc, char **argv)
+{
+    int presses = 200, bounce = 12, seed = 1, opt;
+    int ok;
+
+    while ((opt = getopt(argc, argv, "n:b:s:")) != -1) {
+        switch (opt) {
+            case 'n': presses = atoi(optarg); break;
+            case 'b': bounce = atoi(optarg); break;
+            case 's': seed = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-n presses] [-b bounce] [-s seed]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (bounce >= DEBOUNCE_BATCH_STABLE) {
+        fprintf(stderr, "bounce must stay under %d samples\n", DEBOUNCE_BATCH_STABLE);
+        return 2;
+    }
+
+    srand((unsigned)seed);
+    buildStream(presses, bounce);
+
+    ok = checkEdges();
+    printf("%u true edges: %s\n", numTruth, ok ? "all reported once, on time" : "FAILED");
+    timeKernels();
+
+    return ok ? 0 : 1;
+}
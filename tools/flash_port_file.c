@@ -0,0 +1,158 @@
+/*=================================================================
+ * @file: flash_port_file.c
+ * @brief: Host build of flash_port.h, backed by an image file
+ *
+ * Stands in for Final_project_flash_port.c so store.c can run on a
+ * PC against a file that keeps its contents between runs:
+ *
+ *   gcc -DSTORE_HOST -I<headers> Final_project_store.c \
+ *       tools/flash_port_file.c tools/store_host.c
+ *
+ * Flash rules are kept: erase sets a whole page to 0xFF, and a
+ * double-word can only be programmed once after an erase (a second
+ * program fails with FLASH_PORT_PROGERR and changes nothing).
+ *
+ * Environment:
+ *   FLASH_IMAGE  image file (default flash_store.bin), created
+ *                erased if missing
+ *   FLASH_CUT    n: the n-th erase/program is cut short and the
+ *                process exits with status 3, like a power loss.
+ *                A cut program writes only the low word, a cut
+ *                erase only the first half of the page.
+ * Running the driver again on the same image tests the recovery;
+ * tools/store_host.c does that for every operation in turn. The
+ * ECC error a real cut program can cause is not modelled: the
+ * half-written double-word reads back, which is the harder case.
+ *===============================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flash_port.h"
+
+#define FLASH_PORT_PROGERR 0x8        // same bit as FLASH_SR_PROGERR
+
+static uint8_t image[STORE_SIZE];
+static int loaded;
+static int lastError;
+static long operations;
+
+/****************************************************************************
+ * imagePath()
+ * @parameter: None
+ * @return: the image file name
+ ****************************************************************************/
+static const char *imagePath(void)
+{
+    const char *path = getenv("FLASH_IMAGE");
+    return path ? path : "flash_store.bin";
+}
+
+/****************************************************************************
+ * load() / save()
+ * Read the image on first use, write it back after every operation.
+ ****************************************************************************/
+static void load(void)
+{
+    FILE *f;
+
+    if (loaded)
+        return;
+    loaded = 1;
+
+    memset(image, 0xFF, sizeof(image));
+    f = fopen(imagePath(), "rb");
+    if (f) {
+        if (fread(image, 1, sizeof(image), f) != sizeof(image))
+            fprintf(stderr, "flash_port_file: short image, rest left erased\n");
+        fclose(f);
+    }
+}
+
+static void save(void)
+{
+    FILE *f = fopen(imagePath(), "wb");
+
+    if (!f) {
+        perror(imagePath());
+        exit(1);
+    }
+    fwrite(image, 1, sizeof(image), f);
+    fclose(f);
+}
+
+/****************************************************************************
+ * cutNow()
+ * @parameter: None
+ * @return: 1 if this operation is the one FLASH_CUT asks to interrupt
+ ****************************************************************************/
+static int cutNow(void)
+{
+    const char *cut = getenv("FLASH_CUT");
+
+    operations++;
+    return cut && atol(cut) == operations;
+}
+
+static void powerLoss(void)
+{
+    save();
+    fprintf(stderr, "flash_port_file: power cut at operation %ld\n", operations);
+    exit(3);
+}
+
+int flashPortBusy(void)
+{
+    return 0;                         // operations finish immediately
+}
+
+int flashPortError(void)
+{
+    int error = lastError;
+    lastError = 0;
+    return error;
+}
+
+void flashPortStartErase(uint32_t page)
+{
+    uint8_t *p;
+
+    load();
+    p = &image[page * STORE_PAGE_SIZE];
+
+    if (cutNow()) {
+        memset(p, 0xFF, STORE_PAGE_SIZE / 2);
+        powerLoss();
+    }
+    memset(p, 0xFF, STORE_PAGE_SIZE);
+    save();
+}
+
+void flashPortStartProgram(uint32_t offset, uint32_t lo, uint32_t hi)
+{
+    uint32_t words[2];
+
+    load();
+    memcpy(words, &image[offset], 8);
+    if (words[0] != 0xFFFFFFFFUL || words[1] != 0xFFFFFFFFUL) {
+        lastError = FLASH_PORT_PROGERR;
+        return;
+    }
+
+    if (cutNow()) {
+        memcpy(&image[offset], &lo, 4);
+        powerLoss();
+    }
+    memcpy(&image[offset], &lo, 4);
+    memcpy(&image[offset + 4], &hi, 4);
+    save();
+}
+
+uint32_t flashPortRead(uint32_t offset)
+{
+    uint32_t word;
+
+    load();
+    memcpy(&word, &image[offset], 4);
+    return word;
+}
@@ -0,0 +1,49 @@
+#!/bin/sh
+#
+# hot_symbols.sh
+#
+# Prints where each hot ISR symbol was placed and how big it is:
+#   tools/hot_symbols.sh emu/build/pong.elf
+#
+# Region is worked out from the address: FLASH (0x08...), SRAM1 (0x20...)
+# or SRAM2 (0x10...). Anything hot that still shows FLASH is missing its
+# RAMFUNC / SRAM2_DATA attribute (see memmap.h).
+
+ELF=${1:-emu/build/pong.elf}
+NM=${NM:-arm-none-eabi-nm}
+
+HOT="SysTick_Handler PendSV_Handler playTick multiballTick multiballStep \
+TIM2_IRQHandler wcetStop irqStatsEntry \
+deferToPendSV irqDeferredEntry update_LEDs_PC5to12 shiftLeft \
+EXTI0_IRQHandler EXTI1_IRQHandler EXTI15_10_IRQHandler captureNow \
+shiftRight serve updatePlayerScore setLedPattern getCurrentLedPattern \
+matrixSetRow TIM7_IRQHandler brightnessSetOn TIM1_BRK_TIM15_IRQHandler \
+netTick netGameStep netSessionAdvance USART1_IRQHandler \
+DMA1_Channel6_IRQHandler debounceBatch samplerEdge \
+playStep nextStep ticklessArm ticklessDisarm ticklessIrq \
+schedPost schedPostAt TIM5_IRQHandler winFlow coroPost coroTake \
+poolAlloc poolFree irqTickDefer loadRead diagTick \
+soundPlay DMA1_Channel3_IRQHandler \
+gameState ledPattern led_mode buttons"
+
+printf '%-24s %-6s %-10s %s\n' SYMBOL REGION ADDRESS SIZE
+$NM -S -C "$ELF" | awk -v hot="$HOT" '
+function hex(s,   v, i) {
+    v = 0
+    for (i = 1; i <= length(s); i++)
+        v = v * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1
+    return v
+}
+BEGIN { n = split(hot, names, " "); for (i = 1; i <= n; i++) want[names[i]] = 1 }
+NF == 4 && ($4 in want) {
+    addr = $1
+    region = "?"
+    if (addr ~ /^08/) region = "FLASH"
+    else if (addr ~ /^20/) region = "SRAM1"
+    else if (addr ~ /^10/) region = "SRAM2"
+    printf "%-24s %-6s 0x%s %d\n", $4, region, addr, hex($2)
+    seen[$4] = 1
+}
+END {
+    for (s in want) if (!(s in seen)) printf "%-24s %-6s\n", s, "n/a"
+}'
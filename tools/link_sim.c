@@ -0,0 +1,253 @@
+/*=================================================================
+ * @file: link_sim.c
+ * @brief: Host run of two netplay boards over a socketpair
+ *
+ * Forks one process per board. Each runs the real link.c framing and
+ * netplay.c session, with a bot on its paddle, and talks to the
+ * other through a socketpair that adds delay, loss and corruption:
+ *
+ *   gcc -DLINK_HOST -I<headers> Final_project_link.c \
+ *       Final_project_netplay.c tools/link_sim.c -o link_sim
+ *   ./link_sim [-t ticks] [-l latency] [-d drop%] [-c corrupt%] [-s seed]
+ *              [-r tick]
+ *
+ * latency is in game ticks. With -r, player 2's board starts a new
+ * session when it reaches that tick, as if it had been reset or had
+ * left NET_MODE and come back, and both boards have to resync. Both
+ * boards stop at the same tick; the run passes (exit 0) when their
+ * states there hash the same, neither counted a desync, and both
+ * took the same wins (netSessionTakeWin()) since their last resync.
+ *===============================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "link.h"
+#include "netplay.h"
+
+#define MAX_QUEUED 256
+#define FRAME_MAX  (LINK_MAX_PAYLOAD + 4)
+
+typedef struct {
+    long due;
+    uint8_t len;
+    uint8_t data[FRAME_MAX];
+} Delayed;
+
+static int sock = -1;
+static long now;
+static long latency = 2;
+static long restartAt = -1;
+static int dropPct, corruptPct;
+static uint32_t rng;
+static Delayed queue[MAX_QUEUED];
+static int queued;
+
+/****************************************************************************
+ * nextRandom()
+ * @parameter: None
+ * @return: 0..99 (LCG, per board seed)
+ ****************************************************************************/
+static int nextRandom(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return (int)((rng >> 16) % 100);
+}
+
+/****************************************************************************
+ * linkPortWrite()
+ * @parameter: data, len - one frame
+ * @return: 1 if accepted
+ * Holds the frame for `latency` ticks; may drop it or flip one bit.
+ ****************************************************************************/
+int linkPortWrite(const uint8_t *data, uint8_t len)
+{
+    Delayed *d;
+
+    if (queued == MAX_QUEUED)
+        return 0;
+    if (nextRandom() < dropPct)
+        return 1;                      // lost on the wire
+
+    d = &queue[queued++];
+    d->due = now + latency;
+    d->len = len;
+    memcpy(d->data, data, len);
+    if (nextRandom() < corruptPct)
+        d->data[nextRandom() % len] ^= (uint8_t)(1u << (nextRandom() % 8));
+    return 1;
+}
+
+/****************************************************************************
+ * linkPortRead()
+ * @parameter: byte - receives the next byte
+ * @return: 1 if there was one
+ ****************************************************************************/
+int linkPortRead(uint8_t *byte)
+{
+    return recv(sock, byte, 1, MSG_DONTWAIT) == 1;
+}
+
+/****************************************************************************
+ * flushDue()
+ * @parameter: None
+ * @return: None
+ * Puts frames whose delay is over on the socket, in order.
+ ****************************************************************************/
+static void flushDue(void)
+{
+    int kept = 0;
+
+    for (int i = 0; i < queued; i++) {
+        if (queue[i].due <= now) {
+            // The other board may already have stopped: not an error
+            send(sock, queue[i].data, queue[i].len, MSG_NOSIGNAL);
+        }
+        else {
+            queue[kept++] = queue[i];
+        }
+    }
+    queued = kept;
+}
+
+/****************************************************************************
+ * botPressing()
+ * @parameter: s - session, player - 0 or 1
+ * @return: 1 to hold the paddle button this tick
+ * Serves after a while, usually hits on the paddle cell, and now and
+ * then presses early or at random.
+ ****************************************************************************/
+static int botPressing(const NetSession *s, uint8_t player)
+{
+    const NetGame *g = &s->game;
+    int8_t paddle = player ? NET_CELLS - 1 : 0;
+    int8_t toward = player ? 1 : -1;
+
+    if (g->dir == 0)
+        return g->server == player && nextRandom() < 20;
+    if (g->dir == toward && g->pos == paddle)
+        return nextRandom() < 80;
+    return nextRandom() < 3;
+}
+
+/****************************************************************************
+ * runBoard()
+ * @parameter: player - 0 or 1, ticks - where to stop,
+ *             result - pipe for {stopped cleanly, state hash}
+ * @return: None
+ ****************************************************************************/
+static void runBoard(uint8_t player, uint16_t ticks, int result)
+{
+    static NetSession s;
+    uint8_t packet[LINK_MAX_PAYLOAD];
+    uint8_t len;
+    uint8_t report[3];
+    long linger = -1;
+    uint32_t resyncs = 0;
+    uint8_t wins = 0;
+
+    netSessionInit(&s, player, (uint16_t)(rng >> 16));
+
+    for (now = 0; now < (long)ticks * 20; now++) {
+        if (player == 1 && s.tick == restartAt) {
+            netSessionInit(&s, player, (uint16_t)(s.id + 1));
+            restartAt = -1;
+            wins = 0;
+        }
+        if (s.tick != ticks)
+            netSessionAdvance(&s, botPressing(&s, player));
+
+        linkSend(packet, netSessionPacket(&s, packet));
+        flushDue();
+        while ((len = linkPoll(packet)) != 0)
+            netSessionReceive(&s, packet, len);
+
+        if (s.stats.resyncs != resyncs) {
+            resyncs = s.stats.resyncs;
+            wins = 0;
+        }
+        if (netSessionTakeWin(&s))
+            wins++;
+
+        // Both sides have everything: keep acking a little longer
+        if (linger < 0 && s.tick == ticks && s.remoteTick == ticks && s.peerAck == ticks)
+            linger = now + 4 * latency + 20;
+        if (linger >= 0 && now >= linger)
+            break;
+
+        usleep(200);
+    }
+
+    printf("player %d: tick %u hash %02x score %u-%u wins %u rollbacks %u depth %u "
+           "stalls %u desyncs %u resyncs %u bad %u crc %u\n",
+           player + 1, s.tick, netGameHash(&s.game), s.game.score[0], s.game.score[1],
+           wins, s.stats.rollbacks, s.stats.maxDepth, s.stats.stalls, s.stats.desyncs,
+           s.stats.resyncs, s.stats.badPackets, linkStats.crcErrors);
+    fflush(stdout);
+
+    report[0] = linger >= 0 && s.stats.desyncs == 0;
+    report[1] = netGameHash(&s.game);
+    report[2] = wins;
+    if (write(result, report, sizeof(report)) != sizeof(report))
+        exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    int fds[2], results[2], opt;
+    uint8_t report[2][3] = { { 0 } };
+    uint16_t ticks = 2000;
+    uint32_t seed = 1;
+    pid_t pid[2];
+
+    while ((opt = getopt(argc, argv, "t:l:d:c:s:r:")) != -1) {
+        switch (opt) {
+        case 't': ticks = (uint16_t)atoi(optarg); break;
+        case 'l': latency = atol(optarg); break;
+        case 'd': dropPct = atoi(optarg); break;
+        case 'c': corruptPct = atoi(optarg); break;
+        case 's': seed = (uint32_t)atoi(optarg); break;
+        case 'r': restartAt = atol(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-t ticks] [-l latency] [-d drop%%] "
+                            "[-c corrupt%%] [-s seed] [-r tick]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0 || pipe(results) != 0) {
+        perror("link_sim");
+        return 2;
+    }
+
+    for (int p = 0; p < 2; p++) {
+        pid[p] = fork();
+        if (pid[p] == 0) {
+            sock = fds[p];
+            close(fds[p ^ 1]);
+            rng = seed * 2654435761u + (uint32_t)p;
+            close(results[0]);
+            runBoard((uint8_t)p, ticks, results[1]);
+            exit(0);
+        }
+    }
+    close(fds[0]);
+    close(fds[1]);
+    close(results[1]);
+
+    for (int p = 0; p < 2; p++)
+        waitpid(pid[p], NULL, 0);
+    if (read(results[0], report, sizeof(report)) != sizeof(report))
+        report[0][0] = 0;
+
+    if (!report[0][0] || !report[1][0] || report[0][1] != report[1][1] ||
+        report[0][2] != report[1][2]) {
+        printf("DESYNC\n");
+        return 1;
+    }
+    printf("in step\n");
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*=================================================================
+ * @file: matrix_host.c
+ * @brief: Host SPI capture of the LED matrix stream
+ *
+ * Plays the words matrix.c hands to DMA1 channel 5 into a model of
+ * the MAX7219 on SPI2: each 16-bit frame is shifted in MSB first
+ * and latched when the NSS pulse raises LOAD, and the chip shows
+ * its digit registers as rows under the decode, scan limit,
+ * shutdown and test registers. The DMA is circular, so the words
+ * are played in a loop, one pass after another:
+ *
+ *   gcc -DMATRIX_HOST -I<headers> Final_project_matrix.c \
+ *       tools/matrix_host.c -o matrix_host
+ *   ./matrix_host [-s seed]
+ *
+ * The checks draw with matrixSetRow(), matrixSetFrame() and
+ * matrixClear() and compare what the chip shows after the next pass,
+ * draw while the stream is running, and power the chip up partway
+ * through a word to check the setup words bring it back.
+ * Exit 0 when every check passes.
+ *===============================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "matrix.h"
+
+#define REG_DECODE    0x09
+#define REG_INTENSITY 0x0A
+#define REG_SCANLIMIT 0x0B
+#define REG_SHUTDOWN  0x0C
+#define REG_TEST      0x0F
+#define REG_DIGIT0    0x01
+
+typedef struct {
+    uint16_t shift;                // shift register, DIN clocked in MSB first
+    uint8_t reg[16];               // registers by address
+    uint32_t latches;              // LOAD rising edges
+} Max7219;
+
+static const volatile uint16_t *words;
+static uint8_t numWords;
+static uint8_t dmaPos;             // next word DMA1 channel 5 reads
+static uint32_t rng;
+
+static uint8_t nextRandom(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return (uint8_t)(rng >> 24);
+}
+
+/****************************************************************************
+ * powerUp()
+ * @parameter: chip
+ * @return: None
+ * Datasheet power-up state: shutdown, blanked, control registers
+ * cleared. The digit RAM and the shift register hold whatever they
+ * came up with.
+ ****************************************************************************/
+static void powerUp(Max7219 *chip)
+{
+    memset(chip, 0, sizeof(*chip));
+    chip->shift = (uint16_t)(nextRandom() << 8 | nextRandom());
+    for (int d = 0; d < MATRIX_ROWS; d++)
+        chip->reg[REG_DIGIT0 + d] = nextRandom();
+}
+
+/****************************************************************************
+ * clockBits()
+ * @parameter: chip, word - SPI frame, bits - how many of its first bits
+ * @return: None
+ ****************************************************************************/
+static void clockBits(Max7219 *chip, uint16_t word, int bits)
+{
+    for (int b = 15; b > 15 - bits; b--)
+        chip->shift = (uint16_t)(chip->shift << 1 | ((word >> b) & 1));
+}
+
+// LOAD rising edge: the last 16 bits go to the addressed register
+static void latch(Max7219 *chip)
+{
+    uint8_t addr = (chip->shift >> 8) & 0x0F;
+
+    chip->reg[addr] = (uint8_t)chip->shift;
+    chip->latches++;
+}
+
+/****************************************************************************
+ * sendWord()
+ * @parameter: chip
+ * @return: the word sent
+ * One DMA transfer: SPI2 shifts out the next word, then pulses NSS.
+ ****************************************************************************/
+static uint16_t sendWord(Max7219 *chip)
+{
+    uint16_t word = words[dmaPos];
+
+    dmaPos = (uint8_t)((dmaPos + 1) % numWords);
+    clockBits(chip, word, 16);
+    latch(chip);
+    return word;
+}
+
+static void sendPass(Max7219 *chip)
+{
+    for (uint8_t i = 0; i < numWords; i++)
+        sendWord(chip);
+}
+
+/****************************************************************************
+ * shown()
+ * @parameter: chip, row
+ * @return: the LEDs lit in that row
+ ****************************************************************************/
+static uint8_t shown(const Max7219 *chip, int row)
+{
+    if (chip->reg[REG_TEST] & 1)
+        return 0xFF;
+    if (!(chip->reg[REG_SHUTDOWN] & 1) || row > (chip->reg[REG_SCANLIMIT] & 7))
+        return 0;
+    return chip->reg[REG_DIGIT0 + row];      // decode 0: raw segments
+}
+
+/****************************************************************************
+ * showsFrame()
+ * @parameter: chip, rows - expected frame, what - check name
+ * @return: 1 if the chip shows rows at MATRIX_INTENSITY with no decode
+ ****************************************************************************/
+static int showsFrame(const Max7219 *chip, const uint8_t rows[MATRIX_ROWS], const char *what)
+{
+    int ok = chip->reg[REG_DECODE] == 0 &&
+             (chip->reg[REG_INTENSITY] & 0x0F) == MATRIX_INTENSITY;
+
+    for (int r = 0; r < MATRIX_ROWS; r++) {
+        if (shown(chip, r) != rows[r] || matrixGetRow((uint8_t)r) != rows[r]) {
+            printf("  row %d: shows 0x%02X, drawn 0x%02X, want 0x%02X\n",
+                   r, shown(chip, r), matrixGetRow((uint8_t)r), rows[r]);
+            ok = 0;
+        }
+    }
+    printf("%-28s %s\n", what, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/****************************************************************************
+ * drawWhileRunning()
+ * @parameter: chip
+ * @return: 1 if every row word latched is one of the two frames' rows
+ * Flips between two frames at random points in the stream, the way
+ * the game draws while the DMA runs.
+ ****************************************************************************/
+static int drawWhileRunning(Max7219 *chip)
+{
+    static const uint8_t a[MATRIX_ROWS] = { 0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81 };
+    static const uint8_t b[MATRIX_ROWS] = { 0x7E, 0xBD, 0xDB, 0xE7, 0xE7, 0xDB, 0xBD, 0x7E };
+    int ok = 1;
+
+    matrixSetFrame(a);
+    for (int i = 0; i < 4000; i++) {
+        uint16_t word;
+        uint8_t addr;
+
+        if (nextRandom() < 40)
+            matrixSetFrame((nextRandom() & 1) ? a : b);
+        word = sendWord(chip);
+        addr = word >> 8;
+        if (addr >= REG_DIGIT0 && addr < REG_DIGIT0 + MATRIX_ROWS) {
+            uint8_t row = (uint8_t)(word & 0xFF);
+            if (row != a[addr - REG_DIGIT0] && row != b[addr - REG_DIGIT0])
+                ok = 0;
+        }
+    }
+    matrixSetFrame(b);
+    sendPass(chip);
+    printf("%-28s %s\n", "draw while streaming", ok ? "ok" : "FAIL");
+    return ok && showsFrame(chip, b, "  then one pass");
+}
+
+/****************************************************************************
+ * lateStart()
+ * @parameter: chip, frame - what is drawn
+ * @return: 1 if the chip shows the frame after one whole pass,
+ *          whatever word and bit it powered up in
+ ****************************************************************************/
+static int lateStart(Max7219 *chip, const uint8_t frame[MATRIX_ROWS])
+{
+    int worst = 0;
+
+    for (int at = 0; at < numWords; at++) {
+        for (int bit = 0; bit < 16; bit++) {
+            dmaPos = (uint8_t)at;
+            powerUp(chip);
+            clockBits(chip, words[dmaPos], 16 - bit);   // joins partway through
+            latch(chip);
+            dmaPos = (uint8_t)((dmaPos + 1) % numWords);
+            sendPass(chip);
+            for (int r = 0; r < MATRIX_ROWS; r++) {
+                if (shown(chip, r) != frame[r]) {
+                    printf("  power up at word %d bit %d: row %d wrong\n", at, bit, r);
+                    worst = 1;
+                    break;
+                }
+            }
+        }
+    }
+    printf("%-28s %s\n", "power up mid-stream", worst ? "FAIL" : "ok");
+    return !worst;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint8_t ball[MATRIX_ROWS] = { 0, 0, 0, 0x10, 0, 0, 0, 0 };
+    static const uint8_t frame[MATRIX_ROWS] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+    static const uint8_t blank[MATRIX_ROWS];
+    Max7219 chip;
+    int opt, ok = 1;
+
+    rng = 1;
+    while ((opt = getopt(argc, argv, "s:")) != -1) {
+        if (opt == 's')
+            rng = (uint32_t)strtoul(optarg, NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    words = matrixStream(&numWords);
+    printf("%u words per pass, %u SPI bits\n", numWords, numWords * 16);
+
+    powerUp(&chip);
+    sendPass(&chip);
+    ok &= showsFrame(&chip, blank, "first pass: blank");
+
+    matrixSetRow(MATRIX_COURT_ROW, 0x10);
+    sendPass(&chip);
+    ok &= showsFrame(&chip, ball, "matrixSetRow court row");
+
+    matrixSetFrame(frame);
+    sendPass(&chip);
+    ok &= showsFrame(&chip, frame, "matrixSetFrame");
+
+    ok &= drawWhileRunning(&chip);
+
+    matrixSetFrame(frame);
+    ok &= lateStart(&chip, frame);
+
+    matrixClear();
+    sendPass(&chip);
+    ok &= showsFrame(&chip, blank, "matrixClear");
+
+    printf("%s\n", ok ? "all passed" : "FAIL");
+    return !ok;
+}
@@ -0,0 +1,75 @@
+#!/bin/sh
+#
+# ram_report.sh
+#
+# Static RAM per module, from the linker map of a build:
+#   tools/ram_report.sh emu/build/pong.map
+#
+# Only input sections that made it into the image are counted (the map
+# lists --gc-sections leftovers separately, before the memory map), so
+# this is what each module really costs. SRAM1 is .data + .bss +
+# .noinit + RAMFUNC code; SRAM2 is SRAM2_DATA and RETAINED (see
+# memmap.h). The two stacks are reserved by the linker script and
+# listed at the end; how much of them is used shows in stackUse[] at
+# run time (stack.c).
+
+MAP=${1:-emu/build/pong.map}
+
+awk '
+function hex(s,   v, i) {
+    sub(/^0x/, "", s)
+    v = 0
+    for (i = 1; i <= length(s); i++)
+        v = v * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1
+    return v
+}
+function module(path,   m) {
+    m = path
+    if (m ~ /\)$/) sub(/\(.*/, "", m)      # archive(member.o): the archive
+    sub(/.*\//, "", m)
+    sub(/\.(o|a)$/, "", m)
+    sub(/^Final_project_/, "", m)
+    return m
+}
+BEGIN {
+    printf "%-16s %6s %6s %6s %7s %6s %6s\n", "MODULE", "DATA", "BSS", "NOINIT", "RAMFUNC", "SRAM2", "SRAM1"
+}
+/^Linker script and memory map/ { inmap = 1; next }
+!inmap { next }
+# _Min_Stack_Size = 0x400 and friends
+/^ +0x[0-9a-f]+ +_(Min_Stack|Handler_Stack)_Size = / { stack[$2] = hex($1); next }
+# A long input section name sits alone on its line, the rest follows
+/^ [.A-Za-z_][^ ]*$/ { pending = $1; next }
+{
+    line = $0
+    if (pending != "") { line = pending " " $0; pending = "" }
+    if (split(line, f, " ") != 4 || f[2] !~ /^0x/ || f[3] !~ /^0x/) next
+
+    size = hex(f[3])
+    if (size == 0) next
+    if      (f[1] ~ /^\.RamFunc/)              kind = "ramfunc"
+    else if (f[1] ~ /^\.data/)                 kind = "data"
+    else if (f[1] ~ /^\.bss/ || f[1] == "COMMON") kind = "bss"
+    else if (f[1] ~ /^\.noinit/)               kind = "noinit"
+    else if (f[1] ~ /^\.(sram2|retained)/)    kind = "sram2"
+    else next
+
+    m = module(f[4])
+    mods[m] = 1
+    bytes[m, kind] += size
+    total[kind] += size
+}
+END {
+    for (m in mods) {
+        sram1 = bytes[m, "data"] + bytes[m, "bss"] + bytes[m, "noinit"] + bytes[m, "ramfunc"]
+        printf "%-16s %6d %6d %6d %7d %6d %6d\n", m, bytes[m, "data"], bytes[m, "bss"],
+               bytes[m, "noinit"], bytes[m, "ramfunc"], bytes[m, "sram2"], sram1 | "sort -k7 -n -r"
+    }
+    close("sort -k7 -n -r")
+    sram1 = total["data"] + total["bss"] + total["noinit"] + total["ramfunc"]
+    printf "%-16s %6d %6d %6d %7d %6d %6d\n", "TOTAL", total["data"], total["bss"],
+           total["noinit"], total["ramfunc"], total["sram2"], sram1
+    printf "stacks: thread %d, handler %d bytes reserved\n",
+           stack["_Min_Stack_Size"], stack["_Handler_Stack_Size"]
+}
+' "$MAP"
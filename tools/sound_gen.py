@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+#
+# sound_gen.py
+#
+# Generates the sound effect waveforms played by sound.c:
+#   tools/sound_gen.py > Final_project_sound_tables.c
+#
+# Each effect is a list of notes (frequency in Hz, 0 = rest, and length
+# in ms), synthesized as a square wave with a linear decay per note,
+# 8-bit unsigned around the DAC midscale (128). Every table starts at
+# midscale and ends with two midscale samples: the DAC only outputs a
+# sample at the trigger after DMA wrote it, and the timer is stopped
+# once the last one is written, so the output rests on the one before.
+# RATE must match SOUND_RATE in sound.h (the generated file checks).
+
+RATE = 8000
+AMPLITUDE = 60                 # peak, in DAC steps either side of 128
+
+EFFECTS = [
+    # name        SoundId       notes
+    ('hit',  'SOUND_HIT',  [(1200, 50)]),
+    ('miss', 'SOUND_MISS', [(392, 90), (294, 90), (196, 150)]),
+    ('win',  'SOUND_WIN',  [(523, 110), (0, 20), (659, 110), (0, 20),
+                            (784, 110), (0, 20), (1047, 300)]),
+]
+
+
+def synthesize(notes):
+    samples = [128]
+    for freq, ms in notes:
+        count = RATE * ms // 1000
+        phase = 0.0
+        for i in range(count):
+            if freq == 0:
+                samples.append(128)
+                continue
+            level = AMPLITUDE * (count - i) // count
+            samples.append(128 + level if phase < 0.5 else 128 - level)
+            phase = (phase + freq / RATE) % 1.0
+    samples += [128, 128]
+    return samples
+
+
+def main():
+    print('#include "sound.h"')
+    print()
+    print('/*=================================================================')
+    print(' * @file: sound_tables.c')
+    print(' * @brief: Sound effect waveforms (generated by tools/sound_gen.py)')
+    print(' *')
+    print(' * Do not edit: change the notes in the generator and run')
+    print(' *   tools/sound_gen.py > Final_project_sound_tables.c')
+    print(' *===============================================================*/')
+    print()
+    print('_Static_assert(SOUND_RATE == %d, "tables are for %d Hz: rerun tools/sound_gen.py");'
+          % (RATE, RATE))
+
+    for name, _, notes in EFFECTS:
+        samples = synthesize(notes)
+        print()
+        print('static const uint8_t %sSamples[%d] = {' % (name, len(samples)))
+        for i in range(0, len(samples), 16):
+            print('    ' + ', '.join('%3d' % s for s in samples[i:i + 16]) + ',')
+        print('};')
+
+    print()
+    print('const SoundTable soundTables[NUM_SOUNDS] = {')
+    for name, ident, _ in EFFECTS:
+        print('    [%s] = { %sSamples, sizeof(%sSamples) },' % (ident, name, name))
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,149 @@
+/*=================================================================
+ * @file: sound_host.c
+ * @brief: Host DAC capture of the sound effect tables
+ *
+ * Plays each table in sound_tables.c through a model of the path
+ * sound.c sets up: at every TIM6 trigger the DAC moves DHR8R1 to its
+ * output and requests DMA, which copies the next table byte into
+ * DHR8R1; the transfer-complete interrupt after the last byte stops
+ * TIM6. The DAC output, one value per trigger plus a short tail of
+ * whatever it rests on, is written as an 8-bit mono WAV per effect:
+ *
+ *   gcc -O2 -I<headers> Final_project_sound_tables.c \
+ *       tools/sound_host.c -o sound_host
+ *   ./sound_host [out-dir]
+ *
+ * Exit 0 when every effect takes one interrupt and leaves the output
+ * at midscale, so the speaker is not left holding a DC step.
+ *===============================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sound.h"
+
+#define MIDSCALE   128
+#define TAIL       (SOUND_RATE / 20)      // 50 ms after the interrupt
+
+static const char *const soundName[NUM_SOUNDS] = {
+    [SOUND_HIT]  = "hit",
+    [SOUND_MISS] = "miss",
+    [SOUND_WIN]  = "win",
+};
+
+typedef struct {
+    uint8_t dhr;          // DAC1->DHR8R1
+    uint8_t dor;          // DAC1 output
+    uint32_t cndtr;       // DMA1_Channel3->CNDTR
+    const uint8_t *cmar;  // next byte the channel reads
+    uint8_t running;      // TIM6 CEN
+    uint32_t interrupts;  // DMA1_Channel3_IRQHandler runs
+} DacModel;
+
+/****************************************************************************
+ * trigger()
+ * @parameter: m - DAC, DMA and timer state
+ * @return: None
+ * One TIM6 update: DAC output, DMA request, and the end-of-table
+ * interrupt the firmware takes to stop the timer.
+ ****************************************************************************/
+static void trigger(DacModel *m)
+{
+    m->dor = m->dhr;
+    m->dhr = *m->cmar++;
+    if (--m->cndtr == 0) {
+        m->interrupts++;
+        m->running = 0;
+    }
+}
+
+static void put16(FILE *f, uint16_t v)
+{
+    fputc(v & 0xFF, f);
+    fputc(v >> 8, f);
+}
+
+static void put32(FILE *f, uint32_t v)
+{
+    put16(f, v & 0xFFFF);
+    put16(f, v >> 16);
+}
+
+/****************************************************************************
+ * writeWav()
+ * @parameter: path, samples, count, rate
+ * @return: 0 on success
+ * 8-bit unsigned mono PCM, which is the DAC's own format.
+ ****************************************************************************/
+static int writeWav(const char *path, const uint8_t *samples, uint32_t count, uint32_t rate)
+{
+    FILE *f = fopen(path, "wb");
+
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    fwrite("RIFF", 1, 4, f);
+    put32(f, 36 + count);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put32(f, 16);
+    put16(f, 1);          // PCM
+    put16(f, 1);          // mono
+    put32(f, rate);
+    put32(f, rate);       // bytes per second
+    put16(f, 1);          // block align
+    put16(f, 8);          // bits per sample
+    fwrite("data", 1, 4, f);
+    put32(f, count);
+    fwrite(samples, 1, count, f);
+    if (count & 1)
+        fputc(0, f);      // chunks are word aligned
+    return fclose(f) != 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir = argc > 1 ? argv[1] : ".";
+    const uint32_t rate = SOUND_TIMER_CLK / SOUND_PERIOD;
+    int failed = 0;
+
+    for (int id = 0; id < NUM_SOUNDS; id++) {
+        const SoundTable *t = &soundTables[id];
+        uint8_t *out = malloc(t->length + TAIL);
+        uint32_t count = 0;
+        uint8_t peak = MIDSCALE, trough = MIDSCALE;
+        char path[256];
+
+        if (!out)
+            return 1;
+
+        // soundPlay(): DAC resting at midscale, channel on the table
+        DacModel m = { MIDSCALE, MIDSCALE, t->length, t->samples, 1, 0 };
+
+        while (m.running) {
+            trigger(&m);
+            out[count++] = m.dor;
+            if (m.dor > peak)
+                peak = m.dor;
+            if (m.dor < trough)
+                trough = m.dor;
+        }
+        for (int i = 0; i < TAIL; i++)
+            out[count++] = m.dor;          // timer stopped: output holds
+
+        snprintf(path, sizeof(path), "%s/%s.wav", dir, soundName[id]);
+        failed |= writeWav(path, out, count, rate);
+
+        printf("%-5s %5u samples %4u ms  range %3u..%3u  irqs %u  rest %u/%u  -> %s\n",
+               soundName[id], t->length, t->length * 1000 / rate, trough, peak,
+               m.interrupts, m.dor, m.dhr, path);
+
+        if (m.interrupts != 1 || m.dor != MIDSCALE || m.dhr != MIDSCALE) {
+            printf("  FAIL: %s\n", m.interrupts != 1 ? "interrupt count"
+                                                     : "output not left at midscale");
+            failed = 1;
+        }
+        free(out);
+    }
+
+    return failed;
+}
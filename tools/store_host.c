@@ -0,0 +1,219 @@
+/*=================================================================
+ * @file: store_host.c
+ * @brief: Host power-loss test of the persistent store
+ *
+ * Drives store.c over tools/flash_port_file.c. A writer process sets
+ * one key per step and runs storeService() until storeIdle(), long
+ * enough to compact into the next page more than once. It is run
+ * once per flash operation with FLASH_CUT set to that operation, so
+ * every erase and program is cut short in turn. After each cut a
+ * fresh process runs storeInit() on the image and checks every key
+ * holds the value of the last finished step, or the one being
+ * written when the power went. It then writes once more and checks
+ * that survives a second boot:
+ *
+ *   gcc -DSTORE_HOST -I<headers> Final_project_store.c \
+ *       tools/flash_port_file.c tools/store_host.c -o store_host
+ *   ./store_host [-n steps] [-d dir]
+ *
+ * Exit 0 when every cut recovers.
+ *===============================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "store.h"
+
+#define KEYS        3             // keys the writer cycles through
+#define POWER_CUT   3             // flash_port_file.c exit status
+
+// Values a torn record is most likely to be confused with
+static const uint32_t pattern[] = {
+    0, 0xFFFFFFFFUL, 0x00050005UL, 1, 0xABCDABCDUL, 0, 600000, 0x00010001UL, 2,
+};
+#define NUM_PATTERN (sizeof(pattern) / sizeof(pattern[0]))
+
+static uint32_t stepKey(int step)
+{
+    return (uint32_t)step % KEYS;
+}
+
+static uint32_t stepValue(int step)
+{
+    return pattern[(step + step / KEYS) % NUM_PATTERN];
+}
+
+// Written after a recovery to check the store still works
+static uint32_t marker(int done)
+{
+    return 0x5A5A0000UL + (uint32_t)done;
+}
+
+/****************************************************************************
+ * settle()
+ * @parameter: None
+ * @return: None
+ * Runs the store until everything is in flash.
+ ****************************************************************************/
+static void settle(void)
+{
+    for (int i = 0; i < 100000 && !storeIdle(); i++)
+        storeService();
+}
+
+/****************************************************************************
+ * writer()
+ * @parameter: steps, fd - pipe for the number of the last finished step
+ * @return: never; exits 0 after the last step (POWER_CUT if cut)
+ ****************************************************************************/
+static void writer(int steps, int fd)
+{
+    storeInit();
+    settle();
+    for (int step = 0; step < steps; step++) {
+        storeSet(stepKey(step), stepValue(step));
+        settle();
+        if (write(fd, &step, sizeof(step)) != sizeof(step))
+            exit(1);
+    }
+    exit(0);
+}
+
+/****************************************************************************
+ * recover()
+ * @parameter: done - last finished step (-1 for none)
+ * @return: exits 0 if the image recovers to done or done + 1
+ ****************************************************************************/
+static void recover(int done)
+{
+    int bad = 0;
+
+    storeInit();
+    for (uint32_t key = 0; key < KEYS; key++) {
+        uint32_t value;
+        int have = storeGet(key, &value);
+        int ok = 0;
+
+        // Newest finished value of the key, then the step in flight
+        for (int step = done; step >= 0; step--) {
+            if (stepKey(step) == key) {
+                ok = have && value == stepValue(step);
+                break;
+            }
+            if (step == 0)
+                ok = !have;
+        }
+        if (done < 0)
+            ok = !have;
+        if (!ok && stepKey(done + 1) == key)
+            ok = have && value == stepValue(done + 1);
+
+        if (!ok) {
+            printf("  key %u: %s 0x%08X after step %d\n", key,
+                   have ? "read" : "missing", have ? value : 0, done);
+            bad = 1;
+        }
+    }
+    if (bad)
+        exit(1);
+
+    // The store has to keep working after the cut
+    storeSet(KEYS, marker(done));
+    settle();
+    exit(0);
+}
+
+static void reboot(int done)
+{
+    uint32_t value;
+
+    storeInit();
+    exit(!(storeGet(KEYS, &value) && value == marker(done)));
+}
+
+/****************************************************************************
+ * run()
+ * @parameter: fn - process body, arg
+ * @return: its exit status
+ ****************************************************************************/
+static int run(void (*fn)(int), int arg)
+{
+    int status;
+    pid_t pid;
+
+    fflush(stdout);
+    pid = fork();
+
+    if (pid == 0)
+        fn(arg);
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+int main(int argc, char **argv)
+{
+    int steps = 600;              // about three compactions
+    const char *dir = "/tmp";
+    char image[256], cut[24];
+    int opt, failed = 0;
+    long n;
+
+    while ((opt = getopt(argc, argv, "n:d:")) != -1) {
+        if (opt == 'n')
+            steps = atoi(optarg);
+        else if (opt == 'd')
+            dir = optarg;
+        else {
+            fprintf(stderr, "usage: %s [-n steps] [-d dir]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    snprintf(image, sizeof(image), "%s/store_host_%d.bin", dir, (int)getpid());
+    setenv("FLASH_IMAGE", image, 1);
+
+    for (n = 1; ; n++) {
+        int fds[2], status, step, done = -1;
+        pid_t pid;
+
+        unlink(image);
+        snprintf(cut, sizeof(cut), "%ld", n);
+        setenv("FLASH_CUT", cut, 1);
+
+        if (pipe(fds) != 0)
+            return 1;
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            fclose(stderr);               // one "power cut" line per run
+            writer(steps, fds[1]);
+        }
+        close(fds[1]);
+        while (read(fds[0], &step, sizeof(step)) == sizeof(step))
+            done = step;
+        close(fds[0]);
+        waitpid(pid, &status, 0);
+
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            break;                        // ran to the end: every cut done
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != POWER_CUT) {
+            printf("cut %ld: writer failed\n", n);
+            failed = 1;
+            break;
+        }
+
+        unsetenv("FLASH_CUT");
+        if (run(recover, done) != 0 || run(reboot, done) != 0) {
+            printf("cut %ld (after step %d): not recovered\n", n, done);
+            failed = 1;
+        }
+    }
+
+    unlink(image);
+    printf("%d steps, %ld flash operations cut in turn: %s\n",
+           steps, n - 1, failed ? "FAIL" : "all recovered");
+    return failed;
+}
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+#
+# trace2vcd.py
+#
+# Turns the emulator trace (emu/build/sim_trace.txt, written by
+# emu/pong.resc) into a VCD waveform for GTKWave:
+#   tools/trace2vcd.py emu/build/sim_trace.txt emu/build/pong.vcd
+#
+# The trace times are microseconds with three decimals; the VCD is at
+# 1 ns timescale. Signals:
+#   gpio.P<port><pin>   every output pin that ever changes, from the
+#                       ODR, BSRR and BRR writes
+#   input.P<port><pin>  button pin levels from the script's stimulus
+#   isr.<handler>       1 while the handler is active, so nesting and
+#                       overlap show directly; "other" is any exception
+#                       not traced by name
+#   isr.depth           exception nesting depth
+#
+# A summary (per-handler count and longest run, deepest nesting, and
+# the finest time step in the trace, i.e. the clock's real resolution)
+# goes to stderr, then the boot points with their time and instruction
+# count. Press-to-LED latency is the gap from an input edge to the
+# gpio edge it causes; tick jitter is the spacing of isr.SysTick_Handler.
+
+import sys
+
+
+def parse(path):
+    """Events as (ns, kind, fields), in file order."""
+    events = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split()
+            if len(fields) < 2:
+                continue
+            try:
+                events.append((round(float(fields[0]) * 1000), fields[1], fields[2:]))
+            except ValueError:
+                sys.exit('%s:%d: bad line: %s' % (path, number, line.rstrip()))
+    events.sort(key=lambda e: e[0])   # stable: same-time events keep their order
+    return events
+
+
+def resolution(events):
+    """Smallest gap in ns between two different event times (0 if none)."""
+    times = sorted({e[0] for e in events})
+    return min((b - a for a, b in zip(times, times[1:])), default=0)
+
+
+def vcd_id(index):
+    """Short printable identifier for signal number index."""
+    chars = ''.join(chr(c) for c in range(33, 127))
+    ident = ''
+    while True:
+        ident += chars[index % len(chars)]
+        index //= len(chars)
+        if index == 0:
+            return ident
+
+
+def convert(events, out):
+    odr = {}             # port -> last ODR value
+    changes = []         # (ns, signal, value)
+    isr_stack = []       # [name or None, entry ns] per active exception
+    isr_runs = {}        # name -> [count, longest ns]
+    deepest = 0
+
+    def isr_change(ns, name, value):
+        changes.append((ns, ('isr', name), value))
+
+    for ns, kind, fields in events:
+        if kind in ('O', 'S', 'R'):
+            port, value = fields[0], int(fields[1], 16)
+            old = odr.get(port, 0)
+            if kind == 'O':
+                new = value & 0xFFFF
+            elif kind == 'S':
+                new = (old & ~(value >> 16)) | (value & 0xFFFF)   # set wins
+            else:
+                new = old & ~(value & 0xFFFF)
+            odr[port] = new
+            for pin in range(16):
+                if (old ^ new) >> pin & 1:
+                    changes.append((ns, ('gpio', 'P%s%d' % (port, pin)), new >> pin & 1))
+        elif kind == 'I':
+            changes.append((ns, ('input', 'P' + fields[0]), int(fields[1])))
+        elif kind == 'B':
+            isr_stack.append([None, ns])
+            deepest = max(deepest, len(isr_stack))
+            changes.append((ns, ('isr', 'depth'), len(isr_stack)))
+        elif kind == 'E' and isr_stack and isr_stack[-1][0] is None:
+            isr_stack[-1][0] = fields[0]
+        elif kind == 'X' and isr_stack:
+            name, entry = isr_stack.pop()
+            name = name or 'other'
+            isr_change(entry, name, 1)
+            isr_change(ns, name, 0)
+            run = isr_runs.setdefault(name, [0, 0])
+            run[0] += 1
+            run[1] = max(run[1], ns - entry)
+            changes.append((ns, ('isr', 'depth'), len(isr_stack)))
+
+    # Entries are only named at their return, so sort once more
+    changes.sort(key=lambda c: c[0])
+
+    signals = sorted({c[1] for c in changes})
+    ids = {sig: vcd_id(i) for i, sig in enumerate(signals)}
+
+    out.write('$version trace2vcd.py $end\n$timescale 1ns $end\n$scope module pong $end\n')
+    for scope in ('gpio', 'input', 'isr'):
+        out.write('$scope module %s $end\n' % scope)
+        for sig in signals:
+            if sig[0] == scope:
+                width = 8 if sig == ('isr', 'depth') else 1
+                out.write('$var wire %d %s %s $end\n' % (width, ids[sig], sig[1]))
+        out.write('$upscope $end\n')
+    out.write('$upscope $end\n$enddefinitions $end\n')
+
+    out.write('#0\n$dumpvars\n')
+    for sig in signals:
+        if sig == ('isr', 'depth'):
+            out.write('b0 %s\n' % ids[sig])
+        else:
+            out.write('%s%s\n' % ('1' if sig[0] == 'input' else '0', ids[sig]))
+    out.write('$end\n')
+
+    now = 0
+    for ns, sig, value in changes:
+        if ns != now:
+            out.write('#%d\n' % ns)
+            now = ns
+        if sig == ('isr', 'depth'):
+            out.write('b%s %s\n' % (format(value, 'b'), ids[sig]))
+        else:
+            out.write('%d%s\n' % (value, ids[sig]))
+
+    return isr_runs, deepest
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit('usage: %s <sim_trace.txt> <out.vcd>' % sys.argv[0])
+
+    events = parse(sys.argv[1])
+    with open(sys.argv[2], 'w') as out:
+        isr_runs, deepest = convert(events, out)
+
+    span = events[-1][0] - events[0][0] if events else 0
+    step = resolution(events)
+    sys.stderr.write('%d events over %.3f ms, deepest nesting %d\n' %
+                     (len(events), span / 1e6, deepest))
+    sys.stderr.write('finest time step %d ns%s\n' %
+                     (step, ' (whole microseconds: no sub-us detail)'
+                      if step and all(e[0] % 1000 == 0 for e in events) else ''))
+    for name in sorted(isr_runs):
+        count, longest = isr_runs[name]
+        sys.stderr.write('  %-28s %7d runs, longest %d ns\n' % (name, count, longest))
+    for ns, kind, fields in events:
+        if kind == 'T':
+            sys.stderr.write('  boot %-23s %10.3f us, %s instructions\n' %
+                             (fields[0], ns / 1000, fields[1]))
+
+
+if __name__ == '__main__':
+    main()